@@ -0,0 +1,392 @@
+#include "AssetIndex.h"
+#include "Document.h"
+#include "RawChunkFile.h"
+#include "StringUtils.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+
+namespace LVLExplorerCore
+{
+	static const char* INDEX_FILE_MAGIC = "LVLExplorerIndex";
+	static const int INDEX_FILE_VERSION = 1;
+
+	static void ScanChildren(RawChunkFile& file, const RawChunk& parent, std::vector<AssetLocation>& outAssets)
+	{
+		std::vector<RawChunk> children;
+		if (!file.ReadChildren(parent, children))
+			return;
+
+		for (const RawChunk& child : children)
+		{
+			if (child.m_magic == MakeMagic("lvl_"))
+			{
+				ScanChildren(file, child, outAssets);
+				continue;
+			}
+
+			AssetLocation asset;
+			if (!file.ReadAssetName(child, asset.m_name))
+				continue;
+
+			asset.m_type = child.GetHeaderName();
+			asset.m_position = child.m_position;
+			asset.m_size = child.GetFullSize();
+			outAssets.push_back(std::move(asset));
+		}
+	}
+
+	AssetIndex::AssetIndex()
+	{
+		m_bScanning = false;
+		m_bCancel = false;
+		m_numToScan = 0;
+		m_numScanned = 0;
+		m_numParsed = 0;
+	}
+
+	AssetIndex::~AssetIndex()
+	{
+		CancelScan();
+		WaitUntilDone();
+	}
+
+	bool AssetIndex::ScanFile(const std::string& path, std::vector<AssetLocation>& outAssets)
+	{
+		outAssets.clear();
+
+		RawChunkFile file;
+		if (!file.Open(path))
+			return false;
+
+		RawChunk root;
+		if (!file.ReadChunk(0, root) || root.m_magic != MakeMagic("ucfb"))
+			return false;
+
+		ScanChildren(file, root, outAssets);
+		return true;
+	}
+
+	bool AssetIndex::Load(const std::string& indexPath)
+	{
+		Clear();
+
+		std::ifstream stream(indexPath);
+		if (!stream.is_open())
+			return false;
+
+		std::string magic;
+		int version = 0;
+		stream >> magic >> version;
+		if (magic != INDEX_FILE_MAGIC || version != INDEX_FILE_VERSION)
+			return false;
+
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			if (line.size() < 2)
+				continue;
+
+			std::istringstream fields(line.substr(2));
+			switch (line[0])
+			{
+				case 'D':
+				{
+					m_directory = line.substr(2);
+					break;
+				}
+				case 'F':
+				{
+					IndexedFile file;
+					fields >> file.m_fileSize >> file.m_modifiedTime;
+					fields.get();
+					std::getline(fields, file.m_path);
+					if (fields.fail() || file.m_path.empty())
+					{
+						Clear();
+						return false;
+					}
+					m_files.push_back(std::move(file));
+					break;
+				}
+				case 'A':
+				{
+					if (m_files.empty())
+					{
+						Clear();
+						return false;
+					}
+
+					AssetLocation asset;
+					fields >> asset.m_type >> asset.m_position >> asset.m_size;
+					fields.get();
+					std::getline(fields, asset.m_name);
+					if (fields.fail() || asset.m_name.empty())
+					{
+						Clear();
+						return false;
+					}
+					m_files.back().m_assets.push_back(std::move(asset));
+					break;
+				}
+				default:
+				{
+					Clear();
+					return false;
+				}
+			}
+		}
+
+		RebuildLookup();
+		return true;
+	}
+
+	bool AssetIndex::Save(const std::string& indexPath) const
+	{
+		std::ofstream stream(indexPath, std::ios::trunc);
+		if (!stream.is_open())
+			return false;
+
+		stream << INDEX_FILE_MAGIC << " " << INDEX_FILE_VERSION << "\n";
+		stream << "D " << m_directory << "\n";
+		for (const IndexedFile& file : m_files)
+		{
+			stream << "F " << file.m_fileSize << " " << file.m_modifiedTime << " " << file.m_path << "\n";
+			for (const AssetLocation& asset : file.m_assets)
+			{
+				stream << "A " << asset.m_type << " " << asset.m_position << " " << asset.m_size << " " << asset.m_name << "\n";
+			}
+		}
+		return stream.good();
+	}
+
+	void AssetIndex::Clear()
+	{
+		WaitUntilDone();
+		m_directory.clear();
+		m_files.clear();
+		m_lookup.clear();
+		m_numParsed = 0;
+	}
+
+	bool AssetIndex::StartScan(const std::string& directory, std::string& outError, unsigned int numThreads)
+	{
+		WaitUntilDone();
+
+		std::error_code error;
+		if (!fs::is_directory(directory, error))
+		{
+			outError = "'" + directory + "' is no directory!";
+			return false;
+		}
+
+		if (numThreads == 0)
+		{
+			numThreads = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		m_numToScan = 0;
+		m_numScanned = 0;
+		m_scanError.clear();
+		m_bCancel = false;
+		m_bScanning = true;
+		m_scanThread = std::thread(&AssetIndex::RunScan, this, directory, numThreads);
+		return true;
+	}
+
+	bool AssetIndex::IsScanning() const
+	{
+		return m_bScanning;
+	}
+
+	bool AssetIndex::IsDone() const
+	{
+		return !m_bScanning;
+	}
+
+	float AssetIndex::GetProgress() const
+	{
+		size_t numToScan = m_numToScan;
+		return numToScan > 0 ? (float)m_numScanned / (float)numToScan : 0.0f;
+	}
+
+	void AssetIndex::CancelScan()
+	{
+		m_bCancel = true;
+	}
+
+	void AssetIndex::WaitUntilDone()
+	{
+		if (m_scanThread.joinable())
+		{
+			m_scanThread.join();
+		}
+	}
+
+	size_t AssetIndex::GetNumParsedFiles() const
+	{
+		return m_numParsed;
+	}
+
+	const std::string& AssetIndex::GetScanError() const
+	{
+		return m_scanError;
+	}
+
+	const std::string& AssetIndex::GetDirectory() const
+	{
+		return m_directory;
+	}
+
+	const std::vector<IndexedFile>& AssetIndex::GetFiles() const
+	{
+		return m_files;
+	}
+
+	std::vector<AssetIndexEntry> AssetIndex::Find(const std::string& name, const std::string& type) const
+	{
+		std::vector<AssetIndexEntry> result;
+
+		auto it = m_lookup.find(ToLower(name));
+		if (it == m_lookup.end())
+			return result;
+
+		for (const AssetIndexEntry& entry : it->second)
+		{
+			if (type.empty() || entry.m_asset->m_type == type)
+			{
+				result.push_back(entry);
+			}
+		}
+		return result;
+	}
+
+	void AssetIndex::RunScan(std::string directory, unsigned int numThreads)
+	{
+		// reuse whatever did not change since the last scan
+		std::unordered_map<std::string, IndexedFile*> previous;
+		for (IndexedFile& file : m_files)
+		{
+			previous.emplace(file.m_path, &file);
+		}
+
+		std::vector<IndexedFile> files;
+		std::error_code error;
+		fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, error);
+		if (error)
+		{
+			m_scanError = "Could not read directory '" + directory + "': " + error.message();
+			m_bScanning = false;
+			return;
+		}
+
+		for (fs::recursive_directory_iterator end; !error && it != end && !m_bCancel; it.increment(error))
+		{
+			// entries that vanished or cannot be inspected (e.g. broken links) are skipped
+			std::error_code entryError;
+			if (!it->is_regular_file(entryError))
+				continue;
+
+			std::string ext = ToLower(it->path().extension().string());
+			if (ext.empty() || !Document::IsSupportedExtension(ext.substr(1)))
+				continue;
+
+			IndexedFile file;
+			file.m_path = it->path().string();
+			file.m_fileSize = (uint64_t)it->file_size(entryError);
+			if (entryError)
+				continue;
+			file.m_modifiedTime = (int64_t)it->last_write_time(entryError).time_since_epoch().count();
+			if (entryError)
+				continue;
+			files.push_back(std::move(file));
+		}
+
+		// the walk itself failed, the file list is incomplete
+		if (error)
+		{
+			m_scanError = "Could not read directory '" + directory + "': " + error.message();
+			m_bScanning = false;
+			return;
+		}
+
+		// reused assets are only moved over once the scan can no longer be cancelled
+		std::vector<std::pair<size_t, IndexedFile*>> toReuse;
+		std::vector<size_t> toParse;
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			auto prev = previous.find(files[i].m_path);
+			if (prev != previous.end() && prev->second->m_fileSize == files[i].m_fileSize && prev->second->m_modifiedTime == files[i].m_modifiedTime)
+			{
+				toReuse.emplace_back(i, prev->second);
+			}
+			else
+			{
+				toParse.push_back(i);
+			}
+		}
+
+		m_numToScan = toParse.size();
+
+		// every worker grabs the next unparsed file, results go straight into
+		// the files own slot, so no locking is needed
+		std::atomic<size_t> next(0);
+		auto worker = [&]()
+		{
+			size_t i;
+			while (!m_bCancel && (i = next++) < toParse.size())
+			{
+				IndexedFile& file = files[toParse[i]];
+				ScanFile(file.m_path, file.m_assets);
+				++m_numScanned;
+			}
+		};
+
+		std::vector<std::thread> workers;
+		numThreads = (unsigned int)std::min<size_t>(numThreads, toParse.size());
+		for (unsigned int i = 1; i < numThreads; ++i)
+		{
+			workers.emplace_back(worker);
+		}
+		worker();
+		for (std::thread& thread : workers)
+		{
+			thread.join();
+		}
+
+		if (m_bCancel)
+		{
+			m_scanError = "Scan of '" + directory + "' was cancelled!";
+			m_bScanning = false;
+			return;
+		}
+
+		for (const auto& reuse : toReuse)
+		{
+			files[reuse.first].m_assets = std::move(reuse.second->m_assets);
+		}
+
+		m_directory = directory;
+		m_files = std::move(files);
+		m_numParsed = toParse.size();
+		RebuildLookup();
+
+		m_bScanning = false;
+	}
+
+	void AssetIndex::RebuildLookup()
+	{
+		m_lookup.clear();
+		for (const IndexedFile& file : m_files)
+		{
+			for (const AssetLocation& asset : file.m_assets)
+			{
+				m_lookup[ToLower(asset.m_name)].push_back({ &file, &asset });
+			}
+		}
+	}
+}
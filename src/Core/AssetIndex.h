@@ -0,0 +1,94 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace LVLExplorerCore
+{
+	struct AssetLocation
+	{
+		std::string m_type;		// chunk header, e.g. "tex_"
+		std::string m_name;
+		uint64_t m_position;	// absolute position of the chunk header
+		uint64_t m_size;		// full chunk size, header included
+	};
+
+	struct IndexedFile
+	{
+		std::string m_path;
+		uint64_t m_fileSize;
+		int64_t m_modifiedTime;
+		std::vector<AssetLocation> m_assets;
+	};
+
+	struct AssetIndexEntry
+	{
+		const IndexedFile* m_file;
+		const AssetLocation* m_asset;
+	};
+
+	/*
+	 * Maps asset names (and chunk types) to the files and chunk positions they
+	 * are stored at, across all level files of a directory tree.
+	 * Scanning runs asynchronously on a pool of worker threads, poll IsDone()
+	 * just like a LibSWBF2 Container. Files whose size and modification time
+	 * did not change since the last scan (or loaded index) are not parsed again.
+	 * Do not call anything but IsDone() / GetProgress() while a scan is running!
+	 */
+	class AssetIndex
+	{
+	public:
+		AssetIndex();
+		~AssetIndex();
+
+		bool Load(const std::string& indexPath);
+		bool Save(const std::string& indexPath) const;
+		void Clear();
+
+		// numThreads = 0 uses all available hardware threads
+		bool StartScan(const std::string& directory, std::string& outError, unsigned int numThreads = 0);
+		bool IsScanning() const;
+		bool IsDone() const;
+		float GetProgress() const;
+		void WaitUntilDone();
+
+		// Stops a running scan as soon as possible, it then finishes with a scan error
+		void CancelScan();
+
+		// number of files actually parsed (not reused) during the last scan
+		size_t GetNumParsedFiles() const;
+
+		// Empty if the last scan succeeded, the index is left untouched otherwise.
+		// Files that cannot be inspected during the scan are left out of the index.
+		const std::string& GetScanError() const;
+
+		const std::string& GetDirectory() const;
+		const std::vector<IndexedFile>& GetFiles() const;
+
+		// Name lookups are case insensitive. An empty type matches all chunk types.
+		std::vector<AssetIndexEntry> Find(const std::string& name, const std::string& type = "") const;
+
+		// Parses a single file, used by the scan workers
+		static bool ScanFile(const std::string& path, std::vector<AssetLocation>& outAssets);
+
+	private:
+		std::string m_directory;
+		std::vector<IndexedFile> m_files;
+		std::unordered_map<std::string, std::vector<AssetIndexEntry>> m_lookup;
+
+		std::thread m_scanThread;
+		std::atomic<bool> m_bScanning;
+		std::atomic<bool> m_bCancel;
+		std::atomic<size_t> m_numToScan;
+		std::atomic<size_t> m_numScanned;
+		size_t m_numParsed;
+		std::string m_scanError;
+
+	private:
+		void RunScan(std::string directory, unsigned int numThreads);
+		void RebuildLookup();
+	};
+}
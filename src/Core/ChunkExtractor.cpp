@@ -0,0 +1,322 @@
+#include "ChunkExtractor.h"
+#include "RawChunkFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define FILE_OPEN _open
+#define FILE_CLOSE _close
+#define FILE_READ _read
+#define FILE_WRITE _write
+#define FILE_SEEK _lseeki64
+#define OPEN_READ_FLAGS (_O_RDONLY | _O_BINARY)
+#define OPEN_WRITE_FLAGS (_O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY)
+#define OPEN_WRITE_MODE (_S_IREAD | _S_IWRITE)
+#else
+#include <unistd.h>
+#define FILE_OPEN open
+#define FILE_CLOSE close
+#define FILE_READ read
+#define FILE_WRITE write
+#define FILE_SEEK lseek
+#define OPEN_READ_FLAGS (O_RDONLY)
+#define OPEN_WRITE_FLAGS (O_WRONLY | O_CREAT | O_TRUNC)
+#define OPEN_WRITE_MODE (0644)
+#endif
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+
+namespace LVLExplorerCore
+{
+	// used when the kernel cannot copy for us
+	constexpr size_t COPY_BUFFER_SIZE = 8 * 1024 * 1024;
+
+	static bool WriteAll(int target, const void* data, size_t size)
+	{
+		const char* bytes = (const char*)data;
+		while (size > 0)
+		{
+			auto written = FILE_WRITE(target, bytes, (unsigned int)std::min<size_t>(size, COPY_BUFFER_SIZE));
+			if (written <= 0)
+				return false;
+
+			bytes += written;
+			size -= (size_t)written;
+		}
+		return true;
+	}
+
+	ChunkExtractor::ChunkExtractor()
+	{
+		m_source = -1;
+		m_sourceSize = 0;
+	}
+
+	ChunkExtractor::~ChunkExtractor()
+	{
+		Close();
+	}
+
+	bool ChunkExtractor::Open(const std::string& sourcePath, std::string& outError)
+	{
+		Close();
+
+		m_source = FILE_OPEN(sourcePath.c_str(), OPEN_READ_FLAGS);
+		if (m_source < 0)
+		{
+			outError = "Could not open '" + sourcePath + "': " + strerror(errno);
+			return false;
+		}
+
+		auto size = FILE_SEEK(m_source, 0, SEEK_END);
+		if (size < 0)
+		{
+			outError = "Could not determine size of '" + sourcePath + "'!";
+			Close();
+			return false;
+		}
+
+		m_sourcePath = sourcePath;
+		m_sourceSize = (uint64_t)size;
+		return true;
+	}
+
+	void ChunkExtractor::Close()
+	{
+		if (m_source >= 0)
+		{
+			FILE_CLOSE(m_source);
+		}
+		m_source = -1;
+		m_sourcePath.clear();
+		m_sourceSize = 0;
+	}
+
+	uint64_t ChunkExtractor::GetSourceSize() const
+	{
+		return m_sourceSize;
+	}
+
+	bool ChunkExtractor::ExtractChunk(const ChunkRange& chunk, const std::string& targetPath, std::string& outError)
+	{
+		if (!CheckRange(chunk, outError) || !CheckTarget(targetPath, outError))
+			return false;
+
+		int target = FILE_OPEN(targetPath.c_str(), OPEN_WRITE_FLAGS, OPEN_WRITE_MODE);
+		if (target < 0)
+		{
+			outError = "Could not create '" + targetPath + "': " + strerror(errno);
+			return false;
+		}
+
+		bool bSuccess = CopyRange(target, chunk.m_position, chunk.m_size, outError);
+		if (FILE_CLOSE(target) != 0 && bSuccess)
+		{
+			outError = "Could not write '" + targetPath + "': " + strerror(errno);
+			bSuccess = false;
+		}
+		return bSuccess;
+	}
+
+	bool ChunkExtractor::ExtractContainer(const std::vector<ChunkRange>& chunks, const std::string& targetPath, std::string& outError)
+	{
+		uint64_t dataSize = 0;
+		for (const ChunkRange& chunk : chunks)
+		{
+			if (!CheckRange(chunk, outError))
+				return false;
+
+			dataSize += (chunk.m_size + CHUNK_ALIGNMENT - 1) & ~(CHUNK_ALIGNMENT - 1);
+		}
+
+		if (dataSize > UINT32_MAX)
+		{
+			outError = "Selected chunks are too large to fit into one container!";
+			return false;
+		}
+
+		if (!CheckTarget(targetPath, outError))
+			return false;
+
+		int target = FILE_OPEN(targetPath.c_str(), OPEN_WRITE_FLAGS, OPEN_WRITE_MODE);
+		if (target < 0)
+		{
+			outError = "Could not create '" + targetPath + "': " + strerror(errno);
+			return false;
+		}
+
+		// little endian on disk
+		uint8_t header[CHUNK_HEADER_SIZE] = { 'u', 'c', 'f', 'b' };
+		for (int i = 0; i < 4; ++i)
+		{
+			header[4 + i] = (uint8_t)(dataSize >> (i * 8));
+		}
+
+		bool bSuccess = WriteAll(target, header, sizeof(header));
+		if (!bSuccess)
+		{
+			outError = "Could not write '" + targetPath + "': " + strerror(errno);
+		}
+
+		const uint8_t padding[CHUNK_ALIGNMENT] = {};
+		for (size_t i = 0; bSuccess && i < chunks.size(); ++i)
+		{
+			bSuccess = CopyRange(target, chunks[i].m_position, chunks[i].m_size, outError);
+
+			size_t paddingSize = (size_t)((CHUNK_ALIGNMENT - (chunks[i].m_size % CHUNK_ALIGNMENT)) % CHUNK_ALIGNMENT);
+			if (bSuccess && paddingSize > 0 && !WriteAll(target, padding, paddingSize))
+			{
+				outError = "Could not write '" + targetPath + "': " + strerror(errno);
+				bSuccess = false;
+			}
+		}
+
+		if (FILE_CLOSE(target) != 0 && bSuccess)
+		{
+			outError = "Could not write '" + targetPath + "': " + strerror(errno);
+			bSuccess = false;
+		}
+		return bSuccess;
+	}
+
+	void ChunkExtractor::RemoveNestedRanges(std::vector<ChunkRange>& chunks)
+	{
+		std::sort(chunks.begin(), chunks.end(), [](const ChunkRange& a, const ChunkRange& b)
+		{
+			// on equal positions, the larger (outer) chunk comes first
+			return a.m_position != b.m_position ? a.m_position < b.m_position : a.m_size > b.m_size;
+		});
+
+		uint64_t outerEnd = 0;
+		auto end = std::remove_if(chunks.begin(), chunks.end(), [&outerEnd](const ChunkRange& chunk)
+		{
+			if (chunk.m_position + chunk.m_size <= outerEnd)
+				return true;
+
+			outerEnd = chunk.m_position + chunk.m_size;
+			return false;
+		});
+		chunks.erase(end, chunks.end());
+	}
+
+	std::string ChunkExtractor::MakeChunkFileName(const std::string& headerName, uint64_t position)
+	{
+		std::string name = headerName;
+		for (char& c : name)
+		{
+			if (!isalnum((unsigned char)c) && c != '_')
+			{
+				c = '_';
+			}
+		}
+		return name + "_" + std::to_string(position) + ".chunk";
+	}
+
+	bool ChunkExtractor::CheckRange(const ChunkRange& chunk, std::string& outError) const
+	{
+		if (m_source < 0)
+		{
+			outError = "No source file opened!";
+			return false;
+		}
+		if (chunk.m_size == 0 || chunk.m_position + chunk.m_size > m_sourceSize)
+		{
+			outError = "Chunk at position " + std::to_string(chunk.m_position) + " exceeds the source file!";
+			return false;
+		}
+		return true;
+	}
+
+	bool ChunkExtractor::CheckTarget(const std::string& targetPath, std::string& outError) const
+	{
+		// opening the target truncates it, which would destroy the source
+		std::error_code error;
+		if (std::filesystem::equivalent(m_sourcePath, targetPath, error))
+		{
+			outError = "Cannot extract into the source file '" + targetPath + "' itself!";
+			return false;
+		}
+		return true;
+	}
+
+	bool ChunkExtractor::CopyRange(int target, uint64_t position, uint64_t size, std::string& outError)
+	{
+#ifdef __linux__
+		// copy_file_range: data never leaves the kernel, may even be a reflink.
+		// Not available across file systems on older kernels, retry with sendfile then.
+		{
+			loff_t offset = (loff_t)position;
+			uint64_t remaining = size;
+			while (remaining > 0)
+			{
+				ssize_t copied = copy_file_range(m_source, &offset, target, nullptr, (size_t)std::min<uint64_t>(remaining, 1 << 30), 0);
+				if (copied <= 0)
+					break;
+				remaining -= (uint64_t)copied;
+			}
+			if (remaining == 0)
+				return true;
+
+			position += size - remaining;
+			size = remaining;
+		}
+		{
+			off_t offset = (off_t)position;
+			uint64_t remaining = size;
+			while (remaining > 0)
+			{
+				ssize_t copied = sendfile(target, m_source, &offset, (size_t)std::min<uint64_t>(remaining, 1 << 30));
+				if (copied <= 0)
+					break;
+				remaining -= (uint64_t)copied;
+			}
+			if (remaining == 0)
+				return true;
+
+			position += size - remaining;
+			size = remaining;
+		}
+#endif
+
+		std::unique_ptr<char[]> buffer(new char[COPY_BUFFER_SIZE]);
+		if (FILE_SEEK(m_source, (int64_t)position, SEEK_SET) < 0)
+		{
+			outError = "Could not seek to position " + std::to_string(position) + ": " + strerror(errno);
+			return false;
+		}
+
+		while (size > 0)
+		{
+			auto numRead = FILE_READ(m_source, buffer.get(), (unsigned int)std::min<uint64_t>(size, COPY_BUFFER_SIZE));
+			if (numRead == 0)
+			{
+				outError = "Unexpected end of source file at position " + std::to_string(position) + "!";
+				return false;
+			}
+			if (numRead < 0)
+			{
+				outError = "Could not read source file at position " + std::to_string(position) + ": " + strerror(errno);
+				return false;
+			}
+			if (!WriteAll(target, buffer.get(), (size_t)numRead))
+			{
+				outError = std::string("Could not write target file: ") + strerror(errno);
+				return false;
+			}
+
+			position += (uint64_t)numRead;
+			size -= (uint64_t)numRead;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LVLExplorerCore
+{
+	struct ChunkRange
+	{
+		uint64_t m_position;	// absolute position of the chunk header
+		uint64_t m_size;		// full chunk size, header included
+	};
+
+	/*
+	 * Copies chunks byte by byte out of a source file, without parsing or
+	 * buffering them in user space where the platform allows it
+	 * (copy_file_range / sendfile on Linux). Falls back to large buffered
+	 * copies everywhere else.
+	 */
+	class ChunkExtractor
+	{
+	public:
+		ChunkExtractor();
+		~ChunkExtractor();
+
+		bool Open(const std::string& sourcePath, std::string& outError);
+		void Close();
+		uint64_t GetSourceSize() const;
+
+		// Writes the given chunk, header included, into a standalone file
+		bool ExtractChunk(const ChunkRange& chunk, const std::string& targetPath, std::string& outError);
+
+		// Writes all given chunks into one file, wrapped into a new ucfb container chunk
+		bool ExtractContainer(const std::vector<ChunkRange>& chunks, const std::string& targetPath, std::string& outError);
+
+		// Sorts by position and drops every range that lies within a preceding one,
+		// so selecting a parent and some of its children does not duplicate data
+		static void RemoveNestedRanges(std::vector<ChunkRange>& chunks);
+
+		// e.g. "tex__1234.chunk", safe to use as a file name on all platforms
+		static std::string MakeChunkFileName(const std::string& headerName, uint64_t position);
+
+	private:
+		int m_source;
+		std::string m_sourcePath;
+		uint64_t m_sourceSize;
+
+	private:
+		bool CheckRange(const ChunkRange& chunk, std::string& outError) const;
+		bool CheckTarget(const std::string& targetPath, std::string& outError) const;
+		bool CopyRange(int target, uint64_t position, uint64_t size, std::string& outError);
+	};
+}
@@ -0,0 +1,27 @@
+#include "ChunkSearch.h"
+
+
+namespace LVLExplorerCore
+{
+	void SearchChunkTree(const ChunkTree& tree, const std::string& search, std::vector<SearchMatch>& outMatches)
+	{
+		outMatches.assign(tree.GetNodeCount(), SearchMatch());
+		if (search.empty())
+			return;
+
+		// Nodes are stored in pre-order, so walking backwards visits
+		// all children before their parent. No recursion needed.
+		for (size_t i = tree.GetNodeCount(); i-- > 0;)
+		{
+			SearchMatch& match = outMatches[i];
+			match.m_foundInName = tree.GetDisplayName(i).find(search) != std::string::npos;
+			match.m_foundInInfo = tree.GetInfoText(i).find(search) != std::string::npos;
+
+			size_t parent = tree.GetNode(i).m_parent;
+			if (parent != ChunkTree::NONE && (match.IsFound() || match.m_foundInChildren))
+			{
+				outMatches[parent].m_foundInChildren = true;
+			}
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "ChunkTree.h"
+
+namespace LVLExplorerCore
+{
+	struct SearchMatch
+	{
+		bool m_foundInName = false;
+		bool m_foundInInfo = false;
+		bool m_foundInChildren = false;
+
+		bool IsFound() const { return m_foundInName || m_foundInInfo; }
+	};
+
+	/*
+	 * Searches the display name and info text of every node for the given
+	 * (case sensitive) string. 'outMatches' receives one entry per node,
+	 * indexed just like the ChunkTree. An empty search string matches nothing.
+	 */
+	void SearchChunkTree(const ChunkTree& tree, const std::string& search, std::vector<SearchMatch>& outMatches);
+}
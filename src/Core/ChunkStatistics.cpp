@@ -0,0 +1,325 @@
+#include "ChunkStatistics.h"
+#include "RawChunkFile.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
+
+namespace LVLExplorerCore
+{
+	struct PartialStatistics
+	{
+		std::unordered_map<std::string, TypeStatistics> m_types;
+		std::vector<AssetStatistics> m_assets;
+		std::vector<LayoutRegion> m_layout;
+	};
+
+	static bool IsTopLevelAsset(const ChunkTree& tree, const ChunkNode& node)
+	{
+		if (node.m_parent == ChunkTree::NONE || node.m_headerName == "lvl_")
+			return false;
+
+		const ChunkNode& parent = tree.GetNode(node.m_parent);
+		return parent.m_parent == ChunkTree::NONE || parent.m_headerName == "lvl_";
+	}
+
+	static std::string ReadAssetName(RawChunkFile& file, const ChunkNode& asset)
+	{
+		// same rules as the asset index, so both agree on asset names
+		std::string name;
+		RawChunk chunk;
+		if (file.IsOpen() && file.ReadChunk(asset.m_position, chunk))
+		{
+			file.ReadAssetName(chunk, name);
+		}
+		return name;
+	}
+
+	static void AddUncovered(std::vector<LayoutRegion>& layout, uint64_t start, uint64_t end, size_t nodeIndex)
+	{
+		if (end <= start)
+			return;
+
+		ELayoutRegion kind = end - start < CHUNK_ALIGNMENT ? ELayoutRegion::PADDING : ELayoutRegion::GAP;
+		layout.push_back({ start, end - start, kind, nodeIndex });
+	}
+
+	static void ComputeRange(const ChunkTree& tree, const std::string& sourcePath, size_t begin, size_t end, PartialStatistics& outStats)
+	{
+		RawChunkFile file;
+		file.Open(sourcePath);
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			const ChunkNode& node = tree.GetNode(i);
+
+			uint64_t childBytes = 0;
+			for (size_t child : node.m_children)
+			{
+				childBytes += tree.GetNode(child).m_fullSize;
+			}
+
+			TypeStatistics& type = outStats.m_types[node.m_headerName];
+			type.m_count++;
+			type.m_totalBytes += node.m_fullSize;
+			type.m_selfBytes += node.m_fullSize - std::min<uint64_t>(childBytes, node.m_fullSize);
+
+			if (IsTopLevelAsset(tree, node))
+			{
+				outStats.m_assets.push_back({
+					i,
+					node.m_headerName,
+					ReadAssetName(file, node),
+					node.m_position,
+					node.m_fullSize,
+					node.m_subtreeEnd - i
+				});
+			}
+
+			const uint64_t dataStart = node.m_position + CHUNK_HEADER_SIZE;
+			const uint64_t dataEnd = dataStart + node.m_dataSize;
+			outStats.m_layout.push_back({ node.m_position, CHUNK_HEADER_SIZE, ELayoutRegion::HEADER, i });
+
+			if (node.m_children.empty())
+			{
+				if (node.m_dataSize > 0)
+				{
+					outStats.m_layout.push_back({ dataStart, node.m_dataSize, ELayoutRegion::DATA, i });
+				}
+				continue;
+			}
+
+			// everything in front of the first child belongs to the parent itself (e.g. lvl_ name hash)
+			uint64_t firstChild = tree.GetNode(node.m_children.front()).m_position;
+			if (firstChild > dataStart)
+			{
+				outStats.m_layout.push_back({ dataStart, firstChild - dataStart, ELayoutRegion::DATA, i });
+			}
+
+			uint64_t position = firstChild;
+			for (size_t child : node.m_children)
+			{
+				const ChunkNode& childNode = tree.GetNode(child);
+				AddUncovered(outStats.m_layout, position, childNode.m_position, i);
+				position = std::max<uint64_t>(position, childNode.m_position + childNode.m_fullSize);
+			}
+			AddUncovered(outStats.m_layout, position, dataEnd, i);
+		}
+	}
+
+	const char* ChunkStatistics::LayoutRegionToString(ELayoutRegion kind)
+	{
+		switch (kind)
+		{
+			case ELayoutRegion::HEADER:
+				return "Header";
+			case ELayoutRegion::DATA:
+				return "Data";
+			case ELayoutRegion::PADDING:
+				return "Padding";
+			case ELayoutRegion::GAP:
+				return "Gap";
+			default:
+				return "Unknown";
+		}
+	}
+
+	void ChunkStatistics::Compute(const ChunkTree& tree, const std::string& sourcePath, unsigned int numThreads)
+	{
+		Clear();
+
+		std::error_code error;
+		m_fileSize = (uint64_t)std::filesystem::file_size(sourcePath, error);
+		if (error)
+		{
+			m_fileSize = 0;
+		}
+
+		const size_t numNodes = tree.GetNodeCount();
+		if (numNodes == 0)
+			return;
+
+		if (numThreads == 0)
+		{
+			numThreads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		numThreads = (unsigned int)std::min<size_t>(numThreads, (numNodes + 1023) / 1024);
+
+		// every thread gets its own contiguous node range and its own results, merged afterwards
+		std::vector<PartialStatistics> partials(numThreads);
+		std::vector<std::thread> workers;
+		const size_t rangeSize = (numNodes + numThreads - 1) / numThreads;
+		for (unsigned int t = 1; t < numThreads; ++t)
+		{
+			size_t begin = std::min(numNodes, t * rangeSize);
+			size_t end = std::min(numNodes, begin + rangeSize);
+			workers.emplace_back(ComputeRange, std::cref(tree), std::cref(sourcePath), begin, end, std::ref(partials[t]));
+		}
+		ComputeRange(tree, sourcePath, 0, std::min(numNodes, rangeSize), partials[0]);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		std::unordered_map<std::string, TypeStatistics> types;
+		for (PartialStatistics& partial : partials)
+		{
+			for (auto& it : partial.m_types)
+			{
+				TypeStatistics& type = types[it.first];
+				type.m_count += it.second.m_count;
+				type.m_totalBytes += it.second.m_totalBytes;
+				type.m_selfBytes += it.second.m_selfBytes;
+			}
+			// partials cover ascending node ranges, so assets stay in file order
+			m_assets.insert(m_assets.end(), partial.m_assets.begin(), partial.m_assets.end());
+			m_layout.insert(m_layout.end(), partial.m_layout.begin(), partial.m_layout.end());
+		}
+
+		for (auto& it : types)
+		{
+			it.second.m_type = it.first;
+			m_types.push_back(std::move(it.second));
+		}
+		std::sort(m_types.begin(), m_types.end(), [](const TypeStatistics& a, const TypeStatistics& b)
+		{
+			return a.m_totalBytes > b.m_totalBytes;
+		});
+
+		std::sort(m_layout.begin(), m_layout.end(), [](const LayoutRegion& a, const LayoutRegion& b)
+		{
+			return a.m_start < b.m_start;
+		});
+
+		// bytes outside of the root chunk
+		const ChunkNode& root = tree.GetNode(tree.GetRoot());
+		if (root.m_position > 0)
+		{
+			m_layout.insert(m_layout.begin(), { 0, root.m_position, ELayoutRegion::GAP, tree.GetRoot() });
+		}
+		uint64_t rootEnd = root.m_position + root.m_fullSize;
+		if (m_fileSize > rootEnd)
+		{
+			AddUncovered(m_layout, rootEnd, m_fileSize, tree.GetRoot());
+		}
+
+		for (const LayoutRegion& region : m_layout)
+		{
+			m_regionBytes[(int)region.m_kind] += region.m_size;
+		}
+	}
+
+	void ChunkStatistics::Clear()
+	{
+		m_fileSize = 0;
+		std::fill(std::begin(m_regionBytes), std::end(m_regionBytes), 0);
+		m_types.clear();
+		m_assets.clear();
+		m_layout.clear();
+	}
+
+	uint64_t ChunkStatistics::GetFileSize() const
+	{
+		return m_fileSize;
+	}
+
+	uint64_t ChunkStatistics::GetBytes(ELayoutRegion kind) const
+	{
+		return m_regionBytes[(int)kind];
+	}
+
+	const std::vector<TypeStatistics>& ChunkStatistics::GetTypes() const
+	{
+		return m_types;
+	}
+
+	const std::vector<AssetStatistics>& ChunkStatistics::GetAssets() const
+	{
+		return m_assets;
+	}
+
+	const std::vector<LayoutRegion>& ChunkStatistics::GetLayout() const
+	{
+		return m_layout;
+	}
+
+	static void WriteCSVField(std::ostream& stream, const std::string& field)
+	{
+		if (field.find_first_of(",\"\n\r") == std::string::npos)
+		{
+			stream << field;
+			return;
+		}
+
+		stream << '"';
+		for (char c : field)
+		{
+			if (c == '"')
+			{
+				stream << '"';
+			}
+			stream << c;
+		}
+		stream << '"';
+	}
+
+	void ChunkStatistics::WriteTypesCSV(std::ostream& stream) const
+	{
+		stream << "Type,Count,TotalBytes,SelfBytes\n";
+		for (const TypeStatistics& type : m_types)
+		{
+			WriteCSVField(stream, type.m_type);
+			stream << "," << type.m_count << "," << type.m_totalBytes << "," << type.m_selfBytes << "\n";
+		}
+	}
+
+	void ChunkStatistics::WriteAssetsCSV(std::ostream& stream) const
+	{
+		stream << "Type,Name,Position,TotalBytes,Chunks\n";
+		for (const AssetStatistics& asset : m_assets)
+		{
+			WriteCSVField(stream, asset.m_type);
+			stream << ",";
+			WriteCSVField(stream, asset.m_name);
+			stream << "," << asset.m_position << "," << asset.m_totalBytes << "," << asset.m_numChunks << "\n";
+		}
+	}
+
+	void ChunkStatistics::WriteLayoutCSV(std::ostream& stream, const ChunkTree& tree) const
+	{
+		stream << "Start,Size,Kind,Chunk\n";
+		for (const LayoutRegion& region : m_layout)
+		{
+			stream << region.m_start << "," << region.m_size << "," << LayoutRegionToString(region.m_kind) << ",";
+			WriteCSVField(stream, tree.GetNode(region.m_nodeIndex).m_headerName);
+			stream << "\n";
+		}
+	}
+
+	bool ChunkStatistics::ExportCSV(const std::string& directory, const ChunkTree& tree, std::string& outError) const
+	{
+		namespace fs = std::filesystem;
+
+		std::ofstream types(fs::path(directory) / "types.csv", std::ios::trunc);
+		std::ofstream assets(fs::path(directory) / "assets.csv", std::ios::trunc);
+		std::ofstream layout(fs::path(directory) / "layout.csv", std::ios::trunc);
+		if (!types.is_open() || !assets.is_open() || !layout.is_open())
+		{
+			outError = "Could not create CSV files in '" + directory + "'!";
+			return false;
+		}
+
+		WriteTypesCSV(types);
+		WriteAssetsCSV(assets);
+		WriteLayoutCSV(layout, tree);
+
+		if (!types.good() || !assets.good() || !layout.good())
+		{
+			outError = "Could not write CSV files in '" + directory + "'!";
+			return false;
+		}
+		return true;
+	}
+}
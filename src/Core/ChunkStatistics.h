@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ChunkTree.h"
+
+namespace LVLExplorerCore
+{
+	struct TypeStatistics
+	{
+		std::string m_type;
+		size_t m_count = 0;
+		uint64_t m_totalBytes = 0;	// full sizes, nested chunks of the same type count twice
+		uint64_t m_selfBytes = 0;	// full sizes minus the full sizes of all children
+	};
+
+	struct AssetStatistics
+	{
+		size_t m_nodeIndex;
+		std::string m_type;
+		std::string m_name;
+		uint64_t m_position;
+		uint64_t m_totalBytes;
+		size_t m_numChunks;			// the asset chunk itself and all nested ones
+	};
+
+	enum class ELayoutRegion
+	{
+		HEADER,		// chunk header (magic + size)
+		DATA,		// data of a leaf chunk, or data of a parent preceding its first child
+		PADDING,	// less than CHUNK_ALIGNMENT unused bytes following a chunk
+		GAP			// anything else not covered by any chunk
+	};
+
+	struct LayoutRegion
+	{
+		uint64_t m_start;
+		uint64_t m_size;
+		ELayoutRegion m_kind;
+		size_t m_nodeIndex;			// owning chunk, or the parent of the gap / padding
+	};
+
+	/*
+	 * Where do the bytes of a level file go? Computed in a single parallel pass
+	 * over a ChunkTree. Top level assets are the children of the root chunk,
+	 * and the children of sub levels (lvl_).
+	 */
+	class ChunkStatistics
+	{
+	public:
+		static const char* LayoutRegionToString(ELayoutRegion kind);
+
+		// 'sourcePath' is only read to retrieve asset names. numThreads = 0 uses all hardware threads.
+		void Compute(const ChunkTree& tree, const std::string& sourcePath, unsigned int numThreads = 0);
+		void Clear();
+
+		uint64_t GetFileSize() const;
+		uint64_t GetBytes(ELayoutRegion kind) const;
+
+		// sorted by total bytes, descending
+		const std::vector<TypeStatistics>& GetTypes() const;
+		const std::vector<AssetStatistics>& GetAssets() const;
+
+		// sorted by position, covers the whole file
+		const std::vector<LayoutRegion>& GetLayout() const;
+
+		void WriteTypesCSV(std::ostream& stream) const;
+		void WriteAssetsCSV(std::ostream& stream) const;
+		void WriteLayoutCSV(std::ostream& stream, const ChunkTree& tree) const;
+
+		// Writes types.csv, assets.csv and layout.csv into the given directory
+		bool ExportCSV(const std::string& directory, const ChunkTree& tree, std::string& outError) const;
+
+	private:
+		uint64_t m_fileSize = 0;
+		uint64_t m_regionBytes[4] = {};
+		std::vector<TypeStatistics> m_types;
+		std::vector<AssetStatistics> m_assets;
+		std::vector<LayoutRegion> m_layout;
+	};
+}
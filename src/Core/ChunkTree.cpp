@@ -0,0 +1,116 @@
+#include "ChunkTree.h"
+#include <exception>
+
+using LibSWBF2::Types::List;
+
+
+namespace LVLExplorerCore
+{
+	void ChunkTree::Build(const GenericBaseChunk* root)
+	{
+		Clear();
+		if (root == nullptr)
+			return;
+
+		AddNode(root, NONE, 0);
+
+		// no two chunks can start at the same position, children start behind their parents header
+		m_positionToNode.reserve(m_nodes.size());
+		for (size_t i = 0; i < m_nodes.size(); ++i)
+		{
+			m_positionToNode.emplace(m_nodes[i].m_position, i);
+		}
+		m_infoCache.resize(m_nodes.size());
+		m_infoCached.resize(m_nodes.size(), false);
+	}
+
+	void ChunkTree::Clear()
+	{
+		m_nodes.clear();
+		m_positionToNode.clear();
+		m_infoCache.clear();
+		m_infoCached.clear();
+	}
+
+	bool ChunkTree::IsEmpty() const
+	{
+		return m_nodes.empty();
+	}
+
+	size_t ChunkTree::GetRoot() const
+	{
+		return m_nodes.empty() ? NONE : 0;
+	}
+
+	size_t ChunkTree::GetNodeCount() const
+	{
+		return m_nodes.size();
+	}
+
+	const ChunkNode& ChunkTree::GetNode(size_t index) const
+	{
+		return m_nodes[index];
+	}
+
+	size_t ChunkTree::FindNode(size_t position, const std::string& headerName) const
+	{
+		auto it = m_positionToNode.find(position);
+		if (it == m_positionToNode.end() || m_nodes[it->second].m_headerName != headerName)
+			return NONE;
+
+		return it->second;
+	}
+
+	std::string ChunkTree::GetDisplayName(size_t index) const
+	{
+		const ChunkNode& node = m_nodes[index];
+		return "[" + std::to_string(node.m_childIndex) + "] " + node.m_headerName;
+	}
+
+	const std::string& ChunkTree::GetInfoText(size_t index) const
+	{
+		if (!m_infoCached[index])
+		{
+			try
+			{
+				m_infoCache[index] = m_nodes[index].m_chunk->ToString().Buffer();
+			}
+			catch (std::exception&)
+			{
+				// sometimes, someone (not LibSWBF2) throws a "string too long" exception (msvcp140d.dll??)
+				// just treat that chunk as having no info... TODO
+				m_infoCache[index].clear();
+			}
+			m_infoCached[index] = true;
+		}
+		return m_infoCache[index];
+	}
+
+	size_t ChunkTree::AddNode(const GenericBaseChunk* chunk, size_t parent, size_t childIndex)
+	{
+		size_t index = m_nodes.size();
+		m_nodes.emplace_back();
+
+		ChunkNode& node = m_nodes[index];
+		node.m_chunk = chunk;
+		node.m_headerName = chunk->GetHeaderName().Buffer();
+		node.m_position = (size_t)chunk->GetPosition();
+		node.m_dataSize = (size_t)chunk->GetDataSize();
+		node.m_fullSize = (size_t)chunk->GetFullSize();
+		node.m_parent = parent;
+		node.m_childIndex = childIndex;
+
+		const List<GenericBaseChunk*>& children = chunk->GetChildren();
+		std::vector<size_t> childNodes;
+		childNodes.reserve(children.Size());
+		for (size_t i = 0; i < children.Size(); ++i)
+		{
+			childNodes.push_back(AddNode(children[i], index, i));
+		}
+
+		// do not hold on to 'node' across the recursion above, m_nodes may have been reallocated
+		m_nodes[index].m_children = std::move(childNodes);
+		m_nodes[index].m_subtreeEnd = m_nodes.size();
+		return index;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "LibSWBF2.h"
+
+namespace LVLExplorerCore
+{
+	using LibSWBF2::Chunks::GenericBaseChunk;
+
+	struct ChunkNode
+	{
+		const GenericBaseChunk* m_chunk;
+		std::string m_headerName;
+
+		size_t m_position;
+		size_t m_dataSize;
+		size_t m_fullSize;
+
+		size_t m_parent;
+		size_t m_childIndex;
+
+		// one past the last node of this nodes subtree, see ChunkTree
+		size_t m_subtreeEnd;
+		std::vector<size_t> m_children;
+	};
+
+	/*
+	 * Flat, toolkit independent mirror of a LibSWBF2 chunk graph.
+	 * Nodes are stored in depth first pre-order, so the subtree of
+	 * any node occupies the index range [index, m_subtreeEnd).
+	 */
+	class ChunkTree
+	{
+	public:
+		static constexpr size_t NONE = (size_t)-1;
+
+		void Build(const GenericBaseChunk* root);
+		void Clear();
+
+		bool IsEmpty() const;
+		size_t GetRoot() const;
+		size_t GetNodeCount() const;
+		const ChunkNode& GetNode(size_t index) const;
+
+		// Returns the node whose chunk header starts at the given file position, or NONE
+		size_t FindNode(size_t position, const std::string& headerName) const;
+
+		// "[childIndex] HEADER", as displayed in the tree view
+		std::string GetDisplayName(size_t index) const;
+
+		// Result of GenericBaseChunk::ToString(), cached on first access.
+		// Not thread safe!
+		const std::string& GetInfoText(size_t index) const;
+
+	private:
+		std::vector<ChunkNode> m_nodes;
+		std::unordered_map<size_t, size_t> m_positionToNode;
+
+		mutable std::vector<std::string> m_infoCache;
+		mutable std::vector<bool> m_infoCached;
+
+	private:
+		size_t AddNode(const GenericBaseChunk* chunk, size_t parent, size_t childIndex);
+	};
+}
@@ -0,0 +1,150 @@
+#include "Document.h"
+#include "StringUtils.h"
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+using LibSWBF2::SWBF2Handle;
+using LibSWBF2::Types::List;
+using LibSWBF2::Wrappers::Level;
+
+
+namespace LVLExplorerCore
+{
+	static std::string GetLowerExtension(const std::string& path)
+	{
+		std::string ext = std::filesystem::path(path).extension().string();
+		if (!ext.empty() && ext[0] == '.')
+		{
+			ext.erase(0, 1);
+		}
+		return ToLower(ext);
+	}
+
+	Document::Document()
+	{
+		m_container = nullptr;
+		m_bLoaded = false;
+	}
+
+	Document::~Document()
+	{
+		Close();
+	}
+
+	bool Document::IsSupportedExtension(const std::string& fileExt)
+	{
+		return fileExt == "lvl" || fileExt == "zafbin" || fileExt == "zaabin" || fileExt == "script" || fileExt == "bnk";
+	}
+
+	bool Document::Open(const std::string& path, std::string& outError)
+	{
+		Close();
+
+		std::string fileExt = GetLowerExtension(path);
+		if (!IsSupportedExtension(fileExt))
+		{
+			outError = "Unknown file extension '" + fileExt + "'!";
+			return false;
+		}
+
+		m_container = Container::Create();
+		if (fileExt == "bnk")
+		{
+			m_container->AddSoundBank(path.c_str());
+		}
+		else
+		{
+			m_container->AddLevel(path.c_str());
+		}
+
+		m_path = path;
+		m_container->StartLoading();
+		return true;
+	}
+
+	void Document::Close()
+	{
+		m_tree.Clear();
+		m_path.clear();
+		m_bLoaded = false;
+
+		if (m_container == nullptr)
+			return;
+
+		Container::Delete(m_container);
+		m_container = nullptr;
+	}
+
+	bool Document::IsOpen() const
+	{
+		return m_container != nullptr;
+	}
+
+	bool Document::IsLoading() const
+	{
+		return m_container != nullptr && !m_bLoaded;
+	}
+
+	bool Document::IsDone() const
+	{
+		return m_container != nullptr && m_container->IsDone();
+	}
+
+	float Document::GetProgress() const
+	{
+		return m_container != nullptr ? m_container->GetOverallProgress() : 0.0f;
+	}
+
+	bool Document::FinishLoading(std::string& outError)
+	{
+		if (!IsDone())
+		{
+			outError = "Loading has not finished yet!";
+			return false;
+		}
+
+		m_bLoaded = true;
+
+		List<SWBF2Handle> handles = m_container->GetLoadedLevels();
+		Level* level = handles.Size() > 0 ? m_container->GetLevel(handles[0]) : nullptr;
+		if (level == nullptr)
+		{
+			outError = "Failed to load '" + m_path + "'!";
+			return false;
+		}
+
+		m_tree.Build(level->GetChunk());
+		if (m_tree.IsEmpty())
+		{
+			outError = "'" + m_path + "' does not contain any chunks!";
+			return false;
+		}
+		return true;
+	}
+
+	bool Document::WaitUntilLoaded(std::string& outError)
+	{
+		if (m_container == nullptr)
+		{
+			outError = "No file opened!";
+			return false;
+		}
+
+		while (!m_container->IsDone())
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return FinishLoading(outError);
+	}
+
+	const std::string& Document::GetPath() const
+	{
+		return m_path;
+	}
+
+	const ChunkTree& Document::GetTree() const
+	{
+		return m_tree;
+	}
+}
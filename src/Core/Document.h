@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include "LibSWBF2.h"
+#include "ChunkTree.h"
+
+namespace LVLExplorerCore
+{
+	using LibSWBF2::Container;
+
+	/*
+	 * One opened game data file (lvl, zafbin, zaabin, script or bnk).
+	 * Loading happens asynchronously through a LibSWBF2 Container, poll
+	 * IsDone() and call FinishLoading() afterwards to build the ChunkTree.
+	 */
+	class Document
+	{
+	public:
+		Document();
+		~Document();
+
+		// Returns whether the given file extension (lower case, without dot) can be opened
+		static bool IsSupportedExtension(const std::string& fileExt);
+
+		bool Open(const std::string& path, std::string& outError);
+		void Close();
+
+		bool IsOpen() const;
+		bool IsLoading() const;
+		bool IsDone() const;
+		float GetProgress() const;
+
+		// Call once IsDone() returns true
+		bool FinishLoading(std::string& outError);
+
+		// Blocks until loading has finished, for headless use
+		bool WaitUntilLoaded(std::string& outError);
+
+		const std::string& GetPath() const;
+		const ChunkTree& GetTree() const;
+
+	private:
+		Container* m_container;
+		ChunkTree m_tree;
+		std::string m_path;
+		bool m_bLoaded;
+	};
+}
@@ -0,0 +1,198 @@
+#include "PreviewWorker.h"
+#include "TexturePreview.h"
+#include <algorithm>
+#include <exception>
+
+
+namespace LVLExplorerCore
+{
+	// pixels composited between two cancellation checks
+	constexpr size_t COMPOSITE_SLICE_PIXELS = 64 * 1024;
+
+	PreviewWorker::PreviewWorker()
+	{
+		m_generation = 0;
+		m_bHasRequest = false;
+		m_bHasResult = false;
+		m_bBusy = false;
+		m_bStop = false;
+	}
+
+	PreviewWorker::~PreviewWorker()
+	{
+		Stop();
+	}
+
+	void PreviewWorker::Start(std::function<void()> onResultReady)
+	{
+		Stop();
+
+		m_onResultReady = std::move(onResultReady);
+		m_bStop = false;
+		m_thread = std::thread(&PreviewWorker::Run, this);
+	}
+
+	void PreviewWorker::Stop()
+	{
+		if (!m_thread.joinable())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bStop = true;
+			++m_generation;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	uint64_t PreviewWorker::Request(size_t nodeIndex, const GenericBaseChunk* chunk)
+	{
+		uint64_t generation;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			generation = ++m_generation;
+			m_request.m_generation = generation;
+			m_request.m_nodeIndex = nodeIndex;
+			m_request.m_chunk = chunk;
+			m_bHasRequest = true;
+
+			// a result published just before this request is outdated already
+			m_bHasResult = false;
+		}
+		m_condition.notify_all();
+		return generation;
+	}
+
+	void PreviewWorker::Cancel()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_generation;
+		m_bHasRequest = false;
+		m_bHasResult = false;
+		m_condition.notify_all();
+	}
+
+	void PreviewWorker::CancelAndWait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		++m_generation;
+		m_bHasRequest = false;
+		m_bHasResult = false;
+		m_condition.notify_all();
+		m_condition.wait(lock, [this]() { return !m_bBusy; });
+	}
+
+	bool PreviewWorker::TakeResult(PreviewResult& outResult)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_bHasResult)
+			return false;
+
+		m_bHasResult = false;
+		if (IsSuperseded(m_result.m_generation))
+			return false;
+
+		outResult = std::move(m_result);
+		return true;
+	}
+
+	bool PreviewWorker::IsSuperseded(uint64_t generation) const
+	{
+		return m_generation != generation;
+	}
+
+	void PreviewWorker::Run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_condition.wait(lock, [this]() { return m_bStop || m_bHasRequest; });
+			if (m_bStop)
+				return;
+
+			// debounce: wait until requests stop coming in
+			uint64_t generation = m_request.m_generation;
+			while (m_condition.wait_for(lock, DEBOUNCE_TIME, [this, generation]() { return m_bStop || m_generation != generation; }))
+			{
+				if (m_bStop)
+					return;
+				if (!m_bHasRequest)
+					break;
+				generation = m_request.m_generation;
+			}
+			if (!m_bHasRequest)
+				continue;
+
+			PreviewRequest request = m_request;
+			m_bHasRequest = false;
+			m_bBusy = true;
+			lock.unlock();
+
+			PreviewResult result;
+			bool bSuccess = Process(request, result);
+
+			lock.lock();
+			m_bBusy = false;
+			m_condition.notify_all();
+
+			if (!bSuccess || IsSuperseded(request.m_generation))
+				continue;
+
+			m_result = std::move(result);
+			m_bHasResult = true;
+
+			if (m_onResultReady)
+			{
+				lock.unlock();
+				m_onResultReady();
+				lock.lock();
+			}
+		}
+	}
+
+	bool PreviewWorker::Process(const PreviewRequest& request, PreviewResult& outResult) const
+	{
+		outResult.m_generation = request.m_generation;
+		outResult.m_nodeIndex = request.m_nodeIndex;
+		if (request.m_chunk == nullptr)
+			return false;
+
+		const uint8_t* rgba = nullptr;
+		if (DecodeTexture(FindTextureBody(request.m_chunk), outResult.m_width, outResult.m_height, rgba))
+		{
+			if (IsSuperseded(request.m_generation))
+				return false;
+
+			const size_t numPixels = (size_t)outResult.m_width * outResult.m_height;
+			outResult.m_rgb.resize(numPixels * 3);
+			for (size_t offset = 0; offset < numPixels; offset += COMPOSITE_SLICE_PIXELS)
+			{
+				if (IsSuperseded(request.m_generation))
+					return false;
+
+				size_t count = std::min(COMPOSITE_SLICE_PIXELS, numPixels - offset);
+				CompositeRGBA(rgba + offset * 4, count, outResult.m_rgb.data() + offset * 3);
+			}
+
+			outResult.m_type = EPreviewType::IMAGE;
+			return true;
+		}
+
+		if (IsSuperseded(request.m_generation))
+			return false;
+
+		try
+		{
+			outResult.m_text = request.m_chunk->ToString().Buffer();
+		}
+		catch (std::exception&)
+		{
+			// see ChunkTree::GetInfoText
+			outResult.m_text.clear();
+		}
+
+		outResult.m_type = EPreviewType::TEXT;
+		return true;
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LibSWBF2.h"
+
+namespace LVLExplorerCore
+{
+	using LibSWBF2::Chunks::GenericBaseChunk;
+
+	enum class EPreviewType
+	{
+		NONE,
+		TEXT,
+		IMAGE
+	};
+
+	struct PreviewResult
+	{
+		uint64_t m_generation = 0;
+		size_t m_nodeIndex = 0;
+		EPreviewType m_type = EPreviewType::NONE;
+
+		// TEXT
+		std::string m_text;
+
+		// IMAGE, tightly packed R8 G8 B8
+		uint16_t m_width = 0;
+		uint16_t m_height = 0;
+		std::vector<uint8_t> m_rgb;
+	};
+
+	/*
+	 * Produces chunk previews (info text or composited texture) on a background
+	 * thread. Every Request() supersedes all older ones: a pending request is
+	 * replaced, a running one is cancelled as soon as possible and its result
+	 * dropped, so only the latest selection ever gets displayed.
+	 * Requests are debounced, i.e. processing starts only once no newer request
+	 * arrived for DEBOUNCE_TIME (e.g. while holding an arrow key in a tree view).
+	 */
+	class PreviewWorker
+	{
+	public:
+		static constexpr std::chrono::milliseconds DEBOUNCE_TIME = std::chrono::milliseconds(40);
+
+		PreviewWorker();
+		~PreviewWorker();
+
+		// 'onResultReady' is called from the worker thread, keep it short
+		// (e.g. just wake up the UI thread, which then calls TakeResult())
+		void Start(std::function<void()> onResultReady);
+		void Stop();
+
+		// Returns the generation of the request, also found in its result
+		uint64_t Request(size_t nodeIndex, const GenericBaseChunk* chunk);
+
+		// Drops all pending work, without waiting for it
+		void Cancel();
+
+		// Drops all pending work and blocks until the worker no longer touches
+		// any chunk. Call this before the chunks are destroyed!
+		void CancelAndWait();
+
+		// Returns false if there is no new result since the last call, or if it
+		// belongs to a request that has been superseded in the meantime
+		bool TakeResult(PreviewResult& outResult);
+
+	private:
+		struct PreviewRequest
+		{
+			uint64_t m_generation = 0;
+			size_t m_nodeIndex = 0;
+			const GenericBaseChunk* m_chunk = nullptr;
+		};
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::function<void()> m_onResultReady;
+
+		std::atomic<uint64_t> m_generation;
+		PreviewRequest m_request;
+		PreviewResult m_result;
+		bool m_bHasRequest;
+		bool m_bHasResult;
+		bool m_bBusy;
+		bool m_bStop;
+
+	private:
+		void Run();
+		bool IsSuperseded(uint64_t generation) const;
+		bool Process(const PreviewRequest& request, PreviewResult& outResult) const;
+	};
+}
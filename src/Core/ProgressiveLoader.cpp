@@ -0,0 +1,198 @@
+#include "ProgressiveLoader.h"
+#include <algorithm>
+
+
+namespace LVLExplorerCore
+{
+	ProgressiveLoader::ProgressiveLoader()
+	{
+		m_numParsed = 0;
+		m_bStop = false;
+	}
+
+	ProgressiveLoader::~ProgressiveLoader()
+	{
+		Close();
+	}
+
+	bool ProgressiveLoader::Open(const std::string& path, std::string& outError)
+	{
+		Close();
+
+		RawChunkFile file;
+		if (!file.Open(path))
+		{
+			outError = "Could not open '" + path + "'!";
+			return false;
+		}
+
+		if (!file.ReadChunk(0, m_root) || m_root.m_magic != MakeMagic("ucfb"))
+		{
+			outError = "'" + path + "' is no ucfb chunk file!";
+			return false;
+		}
+
+		if (!file.ReadChildren(m_root, m_topLevel))
+		{
+			m_topLevel.clear();
+		}
+
+		m_path = path;
+		m_subtrees.resize(m_topLevel.size());
+		return true;
+	}
+
+	void ProgressiveLoader::Close()
+	{
+		if (m_thread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_bStop = true;
+			}
+			m_thread.join();
+		}
+
+		m_path.clear();
+		m_root = RawChunk();
+		m_topLevel.clear();
+		m_subtrees.clear();
+		m_pending.clear();
+		m_parsed.clear();
+		m_numParsed = 0;
+		m_bStop = false;
+	}
+
+	bool ProgressiveLoader::IsOpen() const
+	{
+		return !m_path.empty();
+	}
+
+	const RawChunk& ProgressiveLoader::GetRoot() const
+	{
+		return m_root;
+	}
+
+	const std::vector<RawChunk>& ProgressiveLoader::GetTopLevelChunks() const
+	{
+		return m_topLevel;
+	}
+
+	void ProgressiveLoader::Start(std::function<void()> onSubtreeReady)
+	{
+		if (!IsOpen() || m_thread.joinable())
+			return;
+
+		m_onSubtreeReady = std::move(onSubtreeReady);
+		for (size_t i = 0; i < m_topLevel.size(); ++i)
+		{
+			m_pending.push_back(i);
+		}
+		m_thread = std::thread(&ProgressiveLoader::Run, this);
+	}
+
+	void ProgressiveLoader::Prioritize(size_t topLevelIndex)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = std::find(m_pending.begin(), m_pending.end(), topLevelIndex);
+		if (it == m_pending.end() || it == m_pending.begin())
+			return;
+
+		m_pending.erase(it);
+		m_pending.push_front(topLevelIndex);
+	}
+
+	bool ProgressiveLoader::IsDone() const
+	{
+		return m_numParsed == m_topLevel.size();
+	}
+
+	float ProgressiveLoader::GetProgress() const
+	{
+		return m_topLevel.empty() ? 1.0f : (float)m_numParsed / (float)m_topLevel.size();
+	}
+
+	bool ProgressiveLoader::TakeParsedSubtree(size_t& outTopLevelIndex)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_parsed.empty())
+			return false;
+
+		outTopLevelIndex = m_parsed.front();
+		m_parsed.pop_front();
+		return true;
+	}
+
+	const RawSubtree& ProgressiveLoader::GetSubtree(size_t topLevelIndex) const
+	{
+		return m_subtrees[topLevelIndex];
+	}
+
+	void ProgressiveLoader::Run()
+	{
+		RawChunkFile file;
+		file.Open(m_path);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (!m_bStop && !m_pending.empty())
+		{
+			size_t index = m_pending.front();
+			m_pending.pop_front();
+			lock.unlock();
+
+			// nobody else touches this subtree before it got handed out through m_parsed
+			ParseSubtree(file, m_topLevel[index], index, m_subtrees[index]);
+
+			lock.lock();
+			m_parsed.push_back(index);
+			++m_numParsed;
+
+			if (m_onSubtreeReady)
+			{
+				lock.unlock();
+				m_onSubtreeReady();
+				lock.lock();
+			}
+		}
+	}
+
+	void ProgressiveLoader::ParseSubtree(RawChunkFile& file, const RawChunk& topLevel, size_t topLevelIndex, RawSubtree& outSubtree)
+	{
+		outSubtree.m_nodes.clear();
+		outSubtree.m_nodes.push_back({ topLevel, NONE, topLevelIndex, {} });
+
+		struct PendingNode
+		{
+			RawChunk m_chunk;
+			size_t m_parent;
+			size_t m_childIndex;
+		};
+
+		// children are pushed in reverse, so nodes end up in pre-order
+		std::vector<PendingNode> stack;
+		std::vector<RawChunk> children;
+		size_t parent = 0;
+		RawChunk chunk = topLevel;
+		while (true)
+		{
+			if (file.ReadChildren(chunk, children))
+			{
+				for (size_t i = children.size(); i-- > 0;)
+				{
+					stack.push_back({ children[i], parent, i });
+				}
+			}
+
+			if (stack.empty())
+				break;
+
+			PendingNode next = stack.back();
+			stack.pop_back();
+
+			parent = outSubtree.m_nodes.size();
+			chunk = next.m_chunk;
+			outSubtree.m_nodes.push_back({ next.m_chunk, next.m_parent, next.m_childIndex, {} });
+			outSubtree.m_nodes[next.m_parent].m_children.push_back(parent);
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RawChunkFile.h"
+
+namespace LVLExplorerCore
+{
+	struct RawNode
+	{
+		RawChunk m_chunk;
+		size_t m_parent;		// local index, NONE for the top level chunk itself
+		size_t m_childIndex;
+		std::vector<size_t> m_children;
+	};
+
+	// Chunk structure below one top level chunk, in pre-order. Index 0 is the top level chunk.
+	struct RawSubtree
+	{
+		std::vector<RawNode> m_nodes;
+	};
+
+	/*
+	 * Makes the chunk structure of a file available long before LibSWBF2 has
+	 * finished loading it. Open() only reads the root and top level chunk
+	 * headers, which takes milliseconds regardless of the file size. The
+	 * subtrees below each top level chunk are then parsed on a background
+	 * thread, in file order, unless Prioritize() moves one to the front
+	 * (e.g. because the user expanded or selected it).
+	 * Note that raw parsing has to guess whether chunk data consists of child
+	 * chunks, see RawChunkFile::ReadChildren(), so the result may slightly
+	 * differ from the LibSWBF2 chunk graph.
+	 */
+	class ProgressiveLoader
+	{
+	public:
+		static constexpr size_t NONE = (size_t)-1;
+
+		ProgressiveLoader();
+		~ProgressiveLoader();
+
+		bool Open(const std::string& path, std::string& outError);
+		void Close();
+		bool IsOpen() const;
+
+		const RawChunk& GetRoot() const;
+		const std::vector<RawChunk>& GetTopLevelChunks() const;
+
+		// 'onSubtreeReady' is called from the worker thread, keep it short
+		void Start(std::function<void()> onSubtreeReady);
+		void Prioritize(size_t topLevelIndex);
+
+		bool IsDone() const;
+		float GetProgress() const;
+
+		// Returns false if no further subtree has been parsed since the last call.
+		// The returned subtree stays valid until Close().
+		bool TakeParsedSubtree(size_t& outTopLevelIndex);
+		const RawSubtree& GetSubtree(size_t topLevelIndex) const;
+
+	private:
+		std::string m_path;
+		RawChunk m_root;
+		std::vector<RawChunk> m_topLevel;
+		std::vector<RawSubtree> m_subtrees;
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::function<void()> m_onSubtreeReady;
+		std::deque<size_t> m_pending;
+		std::deque<size_t> m_parsed;
+		std::atomic<size_t> m_numParsed;
+		bool m_bStop;
+
+	private:
+		void Run();
+		static void ParseSubtree(RawChunkFile& file, const RawChunk& topLevel, size_t topLevelIndex, RawSubtree& outSubtree);
+	};
+}
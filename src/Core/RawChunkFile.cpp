@@ -0,0 +1,166 @@
+#include "RawChunkFile.h"
+
+
+namespace LVLExplorerCore
+{
+	static bool IsValidMagic(uint32_t magic)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			uint8_t c = (uint8_t)(magic >> (i * 8));
+			if (c < 0x20 || c > 0x7E)
+				return false;
+		}
+		return true;
+	}
+
+	static uint64_t AlignChunkPosition(uint64_t position)
+	{
+		return (position + CHUNK_ALIGNMENT - 1) & ~(CHUNK_ALIGNMENT - 1);
+	}
+
+	std::string MagicToString(uint32_t magic)
+	{
+		std::string name(4, '\0');
+		for (int i = 0; i < 4; ++i)
+		{
+			name[i] = (char)(uint8_t)(magic >> (i * 8));
+		}
+		return name;
+	}
+
+	bool RawChunkFile::Open(const std::string& path)
+	{
+		Close();
+
+		m_file.open(path, std::ios::binary | std::ios::ate);
+		if (!m_file.is_open())
+			return false;
+
+		m_fileSize = (uint64_t)m_file.tellg();
+		return true;
+	}
+
+	void RawChunkFile::Close()
+	{
+		if (m_file.is_open())
+		{
+			m_file.close();
+		}
+		m_file.clear();
+		m_fileSize = 0;
+	}
+
+	bool RawChunkFile::IsOpen() const
+	{
+		return m_file.is_open();
+	}
+
+	uint64_t RawChunkFile::GetFileSize() const
+	{
+		return m_fileSize;
+	}
+
+	bool RawChunkFile::ReadData(uint64_t position, void* buffer, size_t size)
+	{
+		if (position + size > m_fileSize)
+			return false;
+
+		m_file.clear();
+		m_file.seekg((std::streamoff)position);
+		m_file.read((char*)buffer, (std::streamsize)size);
+		return (size_t)m_file.gcount() == size;
+	}
+
+	bool RawChunkFile::ReadChunk(uint64_t position, RawChunk& outChunk)
+	{
+		uint8_t header[CHUNK_HEADER_SIZE];
+		if (!ReadData(position, header, sizeof(header)))
+			return false;
+
+		// always little endian on disk
+		outChunk.m_magic = (uint32_t)header[0] | ((uint32_t)header[1] << 8) | ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 24);
+		outChunk.m_dataSize = (uint32_t)header[4] | ((uint32_t)header[5] << 8) | ((uint32_t)header[6] << 16) | ((uint32_t)header[7] << 24);
+		outChunk.m_position = position;
+
+		return IsValidMagic(outChunk.m_magic) && outChunk.GetEnd() <= m_fileSize;
+	}
+
+	bool RawChunkFile::ReadChildren(const RawChunk& parent, std::vector<RawChunk>& outChildren)
+	{
+		outChildren.clear();
+
+		uint64_t position = parent.GetDataPosition();
+		const uint64_t end = parent.GetEnd();
+
+		// sub levels start with a name hash and another size before their children
+		if (parent.m_magic == MakeMagic("lvl_"))
+		{
+			position += 8;
+		}
+
+		while (position + CHUNK_HEADER_SIZE <= end)
+		{
+			RawChunk child;
+			if (!ReadChunk(position, child) || child.GetEnd() > end)
+			{
+				outChildren.clear();
+				return false;
+			}
+
+			outChildren.push_back(child);
+			position = AlignChunkPosition(child.GetEnd());
+		}
+
+		// anything left over that is not padding means this was no chunk sequence
+		if (position < end || outChildren.empty())
+		{
+			outChildren.clear();
+			return false;
+		}
+		return true;
+	}
+
+	bool RawChunkFile::ReadString(const RawChunk& chunk, std::string& outText)
+	{
+		outText.resize(chunk.m_dataSize);
+		if (!ReadData(chunk.GetDataPosition(), &outText[0], outText.size()))
+		{
+			outText.clear();
+			return false;
+		}
+
+		size_t terminator = outText.find('\0');
+		if (terminator != std::string::npos)
+		{
+			outText.resize(terminator);
+		}
+		return true;
+	}
+
+	bool RawChunkFile::ReadAssetName(const RawChunk& asset, std::string& outName)
+	{
+		outName.clear();
+
+		std::vector<RawChunk> children;
+		if (!ReadChildren(asset, children))
+			return false;
+
+		// most assets carry a NAME chunk, class definitions (entc, ordc, wpnc, ...) a TYPE chunk
+		const RawChunk* nameChunk = nullptr;
+		for (const RawChunk& child : children)
+		{
+			if (child.m_magic == MakeMagic("NAME"))
+			{
+				nameChunk = &child;
+				break;
+			}
+			if (child.m_magic == MakeMagic("TYPE") && nameChunk == nullptr)
+			{
+				nameChunk = &child;
+			}
+		}
+
+		return nameChunk != nullptr && ReadString(*nameChunk, outName) && !outName.empty();
+	}
+}
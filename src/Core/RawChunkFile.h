@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace LVLExplorerCore
+{
+	// size of a chunk header: 4 bytes magic, 4 bytes data size
+	constexpr uint64_t CHUNK_HEADER_SIZE = 8;
+
+	// chunks always start 4 byte aligned
+	constexpr uint64_t CHUNK_ALIGNMENT = 4;
+
+	constexpr uint32_t MakeMagic(const char (&name)[5])
+	{
+		return (uint32_t)(uint8_t)name[0] | ((uint32_t)(uint8_t)name[1] << 8) | ((uint32_t)(uint8_t)name[2] << 16) | ((uint32_t)(uint8_t)name[3] << 24);
+	}
+
+	std::string MagicToString(uint32_t magic);
+
+	struct RawChunk
+	{
+		uint32_t m_magic = 0;
+		uint64_t m_position = 0;
+		uint32_t m_dataSize = 0;
+
+		uint64_t GetDataPosition() const { return m_position + CHUNK_HEADER_SIZE; }
+		uint64_t GetFullSize() const { return CHUNK_HEADER_SIZE + m_dataSize; }
+		uint64_t GetEnd() const { return m_position + GetFullSize(); }
+		std::string GetHeaderName() const { return MagicToString(m_magic); }
+	};
+
+	/*
+	 * Minimal, LibSWBF2 independent reader for the raw ucfb chunk structure.
+	 * Only reads chunk headers (and strings on request), never whole chunks,
+	 * which makes it suitable for quickly walking many or huge files.
+	 * One instance must not be used by multiple threads at once.
+	 */
+	class RawChunkFile
+	{
+	public:
+		bool Open(const std::string& path);
+		void Close();
+		bool IsOpen() const;
+		uint64_t GetFileSize() const;
+
+		// Reads the chunk header at the given absolute file position
+		bool ReadChunk(uint64_t position, RawChunk& outChunk);
+
+		// Interprets the data of 'parent' as a sequence of child chunks.
+		// Returns false if the data does not look like one (e.g. leaf data).
+		// Takes care of the hash/size prefix of sub level (lvl_) chunks.
+		bool ReadChildren(const RawChunk& parent, std::vector<RawChunk>& outChildren);
+
+		// Reads the data of a string chunk (e.g. NAME) up to the first null terminator
+		bool ReadString(const RawChunk& chunk, std::string& outText);
+
+		// Reads the name of an asset (e.g. tex_, modl, entc) from its NAME or TYPE child.
+		// Returns false if the asset has no (non empty) name.
+		bool ReadAssetName(const RawChunk& asset, std::string& outName);
+
+		bool ReadData(uint64_t position, void* buffer, size_t size);
+
+	private:
+		std::ifstream m_file;
+		uint64_t m_fileSize = 0;
+	};
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace LVLExplorerCore
+{
+	inline std::string ToLower(std::string text)
+	{
+		std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return text;
+	}
+}
@@ -0,0 +1,49 @@
+#include "TexturePreview.h"
+
+using LibSWBF2::Chunks::LVL::texture::tex_;
+using LibSWBF2::ETextureFormat;
+
+
+namespace LVLExplorerCore
+{
+	const BODY* FindTextureBody(const GenericBaseChunk* chunk)
+	{
+		if (chunk == nullptr)
+			return nullptr;
+
+		const tex_* textureChunk = dynamic_cast<const tex_*>(chunk);
+		if (textureChunk != nullptr && textureChunk->m_FMTs.Size() > 0 && textureChunk->m_FMTs[0]->p_Face->m_LVLs.Size() > 0)
+		{
+			return textureChunk->m_FMTs[0]->p_Face->m_LVLs[0]->p_Body;
+		}
+
+		return dynamic_cast<const BODY*>(chunk);
+	}
+
+	bool DecodeTexture(const BODY* body, uint16_t& outWidth, uint16_t& outHeight, const uint8_t*& outRGBA)
+	{
+		outRGBA = nullptr;
+		if (body == nullptr)
+			return false;
+
+		body->GetImageData(ETextureFormat::R8_G8_B8_A8, outWidth, outHeight, outRGBA);
+		return outRGBA != nullptr && outWidth > 0 && outHeight > 0;
+	}
+
+	void CompositeRGBA(const uint8_t* rgba, size_t numPixels, uint8_t* outRGB)
+	{
+		// integer blend, avoids three float conversions per channel
+		for (size_t i = 0; i < numPixels; ++i)
+		{
+			const uint32_t alpha = rgba[3];
+			const uint32_t transparency = 255 - alpha;
+
+			outRGB[0] = uint8_t((rgba[0] * alpha + PREVIEW_ALPHA_COLOR[0] * transparency) / 255);
+			outRGB[1] = uint8_t((rgba[1] * alpha + PREVIEW_ALPHA_COLOR[1] * transparency) / 255);
+			outRGB[2] = uint8_t((rgba[2] * alpha + PREVIEW_ALPHA_COLOR[2] * transparency) / 255);
+
+			rgba += 4;
+			outRGB += 3;
+		}
+	}
+}
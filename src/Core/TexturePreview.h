@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "LibSWBF2.h"
+#include "Chunks/LVL/tex_/tex_.h"
+#include "Chunks/LVL/tex_/BODY.h"
+
+namespace LVLExplorerCore
+{
+	using LibSWBF2::Chunks::GenericBaseChunk;
+	using LibSWBF2::Chunks::LVL::LVL_texture::BODY;
+
+	// transparent pixels are blended against this color
+	constexpr uint8_t PREVIEW_ALPHA_COLOR[3] = { 255, 0, 255 };
+
+	/*
+	 * Returns the texture BODY to preview for the given chunk, or nullptr.
+	 * For a BODY chunk that is the chunk itself, for a tex_ chunk it is the
+	 * first mip map of the first found format.
+	 */
+	const BODY* FindTextureBody(const GenericBaseChunk* chunk);
+
+	// Decodes the given texture BODY to R8 G8 B8 A8
+	bool DecodeTexture(const BODY* body, uint16_t& outWidth, uint16_t& outHeight, const uint8_t*& outRGBA);
+
+	// Blends 'numPixels' R8 G8 B8 A8 pixels against PREVIEW_ALPHA_COLOR into tightly packed R8 G8 B8
+	void CompositeRGBA(const uint8_t* rgba, size_t numPixels, uint8_t* outRGB);
+}
@@ -0,0 +1,249 @@
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Core/AssetIndex.h"
+#include "Core/ChunkExtractor.h"
+#include "Core/ChunkStatistics.h"
+#include "Core/Document.h"
+#include "Core/RawChunkFile.h"
+
+using LVLExplorerCore::AssetIndex;
+using LVLExplorerCore::AssetIndexEntry;
+using LVLExplorerCore::ChunkExtractor;
+using LVLExplorerCore::ChunkRange;
+using LVLExplorerCore::ChunkStatistics;
+using LVLExplorerCore::Document;
+using LVLExplorerCore::ELayoutRegion;
+using LVLExplorerCore::RawChunk;
+using LVLExplorerCore::RawChunkFile;
+
+
+/*
+ * Headless front end to LVLExplorerCore, for batch jobs and build agents.
+ */
+
+static void PrintUsage()
+{
+	printf(
+		"Usage:\n"
+		"  LVLExplorerCli index <directory> <index file>\n"
+		"      Scans all level files in <directory> (recursively) and writes the\n"
+		"      asset index to <index file>. Unchanged files of an existing index are reused.\n"
+		"  LVLExplorerCli find <index file> <asset name> [<chunk type>]\n"
+		"      Lists all files and chunk positions the given asset is stored at.\n"
+		"  LVLExplorerCli extract <level file> <output directory> <chunk position>...\n"
+		"      Writes each chunk starting at the given positions into its own file.\n"
+		"  LVLExplorerCli extract-container <level file> <output file> <chunk position>...\n"
+		"      Writes all chunks starting at the given positions into one new ucfb container.\n"
+		"  LVLExplorerCli stats <level file> <output directory>\n"
+		"      Writes size statistics per chunk type and top level asset, as well as the\n"
+		"      file layout into types.csv, assets.csv and layout.csv.\n"
+	);
+}
+
+static int RunIndex(const std::string& directory, const std::string& indexPath)
+{
+	AssetIndex index;
+	if (index.Load(indexPath) && index.GetDirectory() != directory)
+	{
+		index.Clear();
+	}
+
+	std::string error;
+	if (!index.StartScan(directory, error))
+	{
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+	index.WaitUntilDone();
+
+	if (!index.GetScanError().empty())
+	{
+		fprintf(stderr, "%s\n", index.GetScanError().c_str());
+		return 1;
+	}
+
+	size_t numAssets = 0;
+	for (const LVLExplorerCore::IndexedFile& file : index.GetFiles())
+	{
+		numAssets += file.m_assets.size();
+	}
+
+	if (!index.Save(indexPath))
+	{
+		fprintf(stderr, "Could not write index file '%s'!\n", indexPath.c_str());
+		return 1;
+	}
+
+	printf("Indexed %zu assets in %zu files (%zu parsed, %zu unchanged)\n",
+		numAssets,
+		index.GetFiles().size(),
+		index.GetNumParsedFiles(),
+		index.GetFiles().size() - index.GetNumParsedFiles());
+	return 0;
+}
+
+static int RunFind(const std::string& indexPath, const std::string& name, const std::string& type)
+{
+	AssetIndex index;
+	if (!index.Load(indexPath))
+	{
+		fprintf(stderr, "Could not read index file '%s'!\n", indexPath.c_str());
+		return 1;
+	}
+
+	std::vector<AssetIndexEntry> entries = index.Find(name, type);
+	for (const AssetIndexEntry& entry : entries)
+	{
+		printf("%s\t%s\t%llu\t%llu\t%s\n",
+			entry.m_asset->m_type.c_str(),
+			entry.m_asset->m_name.c_str(),
+			(unsigned long long)entry.m_asset->m_position,
+			(unsigned long long)entry.m_asset->m_size,
+			entry.m_file->m_path.c_str());
+	}
+	return entries.empty() ? 2 : 0;
+}
+
+// Reads the chunk headers at the given positions to determine the chunk sizes
+static bool ReadChunkRanges(const std::string& sourcePath, char* positions[], int numPositions, std::vector<ChunkRange>& outChunks, std::vector<std::string>& outHeaderNames)
+{
+	RawChunkFile file;
+	if (!file.Open(sourcePath))
+	{
+		fprintf(stderr, "Could not open '%s'!\n", sourcePath.c_str());
+		return false;
+	}
+
+	for (int i = 0; i < numPositions; ++i)
+	{
+		// strtoull happily returns 0 (the root chunk) for anything that is no number
+		char* end = nullptr;
+		errno = 0;
+		uint64_t position = strtoull(positions[i], &end, 10);
+		if (!isdigit((unsigned char)positions[i][0]) || *end != '\0' || errno != 0)
+		{
+			fprintf(stderr, "'%s' is no valid chunk position!\n", positions[i]);
+			return false;
+		}
+
+		RawChunk chunk;
+		if (!file.ReadChunk(position, chunk))
+		{
+			fprintf(stderr, "There is no valid chunk at position %s!\n", positions[i]);
+			return false;
+		}
+		outChunks.push_back({ chunk.m_position, chunk.GetFullSize() });
+		outHeaderNames.push_back(chunk.GetHeaderName());
+	}
+	return true;
+}
+
+static int RunExtract(const std::string& sourcePath, const std::string& outDirectory, char* positions[], int numPositions)
+{
+	std::vector<ChunkRange> chunks;
+	std::vector<std::string> headerNames;
+	if (!ReadChunkRanges(sourcePath, positions, numPositions, chunks, headerNames))
+		return 1;
+
+	ChunkExtractor extractor;
+	std::string error;
+	if (!extractor.Open(sourcePath, error))
+	{
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	for (size_t i = 0; i < chunks.size(); ++i)
+	{
+		std::string targetPath = outDirectory + "/" + ChunkExtractor::MakeChunkFileName(headerNames[i], chunks[i].m_position);
+		if (!extractor.ExtractChunk(chunks[i], targetPath, error))
+		{
+			fprintf(stderr, "%s\n", error.c_str());
+			return 1;
+		}
+		printf("%s\n", targetPath.c_str());
+	}
+	return 0;
+}
+
+static int RunExtractContainer(const std::string& sourcePath, const std::string& targetPath, char* positions[], int numPositions)
+{
+	std::vector<ChunkRange> chunks;
+	std::vector<std::string> headerNames;
+	if (!ReadChunkRanges(sourcePath, positions, numPositions, chunks, headerNames))
+		return 1;
+
+	ChunkExtractor::RemoveNestedRanges(chunks);
+
+	ChunkExtractor extractor;
+	std::string error;
+	if (!extractor.Open(sourcePath, error) || !extractor.ExtractContainer(chunks, targetPath, error))
+	{
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	printf("Wrote %zu chunks into '%s'\n", chunks.size(), targetPath.c_str());
+	return 0;
+}
+
+static int RunStats(const std::string& sourcePath, const std::string& outDirectory)
+{
+	Document document;
+	std::string error;
+	if (!document.Open(sourcePath, error) || !document.WaitUntilLoaded(error))
+	{
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	ChunkStatistics stats;
+	stats.Compute(document.GetTree(), sourcePath);
+	if (!stats.ExportCSV(outDirectory, document.GetTree(), error))
+	{
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	printf("File size: %llu, headers: %llu, data: %llu, padding: %llu, gaps: %llu\n",
+		(unsigned long long)stats.GetFileSize(),
+		(unsigned long long)stats.GetBytes(ELayoutRegion::HEADER),
+		(unsigned long long)stats.GetBytes(ELayoutRegion::DATA),
+		(unsigned long long)stats.GetBytes(ELayoutRegion::PADDING),
+		(unsigned long long)stats.GetBytes(ELayoutRegion::GAP));
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 4 && strcmp(argv[1], "index") == 0)
+	{
+		return RunIndex(argv[2], argv[3]);
+	}
+	if (argc >= 4 && strcmp(argv[1], "find") == 0)
+	{
+		return RunFind(argv[2], argv[3], argc >= 5 ? argv[4] : "");
+	}
+
+	if (argc >= 5 && strcmp(argv[1], "extract") == 0)
+	{
+		return RunExtract(argv[2], argv[3], argv + 4, argc - 4);
+	}
+	if (argc >= 5 && strcmp(argv[1], "extract-container") == 0)
+	{
+		return RunExtractContainer(argv[2], argv[3], argv + 4, argc - 4);
+	}
+
+	if (argc >= 4 && strcmp(argv[1], "stats") == 0)
+	{
+		return RunStats(argv[2], argv[3]);
+	}
+
+	PrintUsage();
+	return 1;
+}
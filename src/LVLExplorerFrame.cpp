@@ -4,17 +4,45 @@
 #include <wx/sizer.h>
 #include <wx/file.h>
 #include <wx/filename.h>
+#include <wx/dirdlg.h>
+#include <wx/stdpaths.h>
+#include <wx/config.h>
+#include "StatisticsDialog.h"
+#include <functional>
+#include <cstring>
+#include <chrono>
 
 
 #define ID_MENU_FILE_OPEN 1138
 #define ID_MENU_EXIT 1139
 #define ID_TREE_VIEW 1140
 #define ID_SEARCH 1141
+#define ID_MENU_SCAN_FOLDER 1142
+#define ID_MENU_FIND_ASSET 1143
+#define ID_MENU_EXTRACT_CHUNKS 1144
+#define ID_MENU_EXTRACT_CONTAINER 1145
+#define ID_MENU_STATISTICS 1146
+#define ID_LOAD_TIMER 1147
+#define ID_SCAN_TIMER 1148
+
+// config key of the asset index to use when none has been scanned in this session
+#define CONFIG_LAST_ASSET_INDEX "LastAssetIndex"
+
+// time spent per idle event on adding parsed subtrees to the tree view
+#define STREAMING_IDLE_BUDGET_MS 15
 
 wxBEGIN_EVENT_TABLE(LVLExplorerFrame, wxFrame)
 	EVT_MENU(ID_MENU_FILE_OPEN, LVLExplorerFrame::OnMenuOpenFile)
+	EVT_MENU(ID_MENU_SCAN_FOLDER, LVLExplorerFrame::OnMenuScanFolder)
+	EVT_MENU(ID_MENU_FIND_ASSET, LVLExplorerFrame::OnMenuFindAsset)
 	EVT_MENU(ID_MENU_EXIT, LVLExplorerFrame::OnMenuExit)
+	EVT_MENU(ID_MENU_EXTRACT_CHUNKS, LVLExplorerFrame::OnMenuExtractChunks)
+	EVT_MENU(ID_MENU_EXTRACT_CONTAINER, LVLExplorerFrame::OnMenuExtractContainer)
+	EVT_MENU(ID_MENU_STATISTICS, LVLExplorerFrame::OnMenuStatistics)
 	EVT_TREE_SEL_CHANGED(ID_TREE_VIEW, LVLExplorerFrame::OnTreeSelectionChanges)
+	EVT_TREE_ITEM_EXPANDING(ID_TREE_VIEW, LVLExplorerFrame::OnTreeItemExpanding)
+	EVT_TIMER(ID_LOAD_TIMER, LVLExplorerFrame::OnPollTimer)
+	EVT_TIMER(ID_SCAN_TIMER, LVLExplorerFrame::OnPollTimer)
 	EVT_TEXT_ENTER(ID_SEARCH, LVLExplorerFrame::OnSearch)
 	EVT_IDLE(LVLExplorerFrame::OnIdle)
 wxEND_EVENT_TABLE()
@@ -32,12 +60,22 @@ LVLExplorerFrame::LVLExplorerFrame() : wxFrame(
 	Logger::SetLogfileLevel(ELogType::Warning);
 	//m_timer.Bind(wxEVT_TIMER, &LVLExplorerFrame::OnIdle, this);
 	//m_timer.Start(100);
+	m_loadTimer.SetOwner(this, ID_LOAD_TIMER);
+	m_scanTimer.SetOwner(this, ID_SCAN_TIMER);
 
 	m_menuMain = new wxMenuBar();
 	m_fileMenu = new wxMenu();
 	m_fileMenu->Append(ID_MENU_FILE_OPEN, "Open");
+	m_fileMenu->Append(ID_MENU_SCAN_FOLDER, "Scan Folder...");
+	m_fileMenu->Append(ID_MENU_FIND_ASSET, "Find Asset in Index...");
 	m_fileMenu->Append(ID_MENU_EXIT, "Exit");
 	m_menuMain->Append(m_fileMenu, "File");
+	m_chunkMenu = new wxMenu();
+	m_chunkMenu->Append(ID_MENU_EXTRACT_CHUNKS, "Extract Selected Chunk(s)...");
+	m_chunkMenu->Append(ID_MENU_EXTRACT_CONTAINER, "Extract Selected as Container...");
+	m_chunkMenu->AppendSeparator();
+	m_chunkMenu->Append(ID_MENU_STATISTICS, "Statistics...");
+	m_menuMain->Append(m_chunkMenu, "Chunk");
 	SetMenuBar(m_menuMain);
 
 	m_panelMain = new wxPanel(this, wxID_ANY);
@@ -55,7 +93,8 @@ LVLExplorerFrame::LVLExplorerFrame() : wxFrame(
 		m_panelMain,
 		ID_TREE_VIEW,
 		wxDefaultPosition,
-		wxDefaultSize
+		wxDefaultSize,
+		wxTR_DEFAULT_STYLE | wxTR_MULTIPLE
 	);
 
 	m_textDisplay = new wxTextCtrl(
@@ -71,7 +110,8 @@ LVLExplorerFrame::LVLExplorerFrame() : wxFrame(
 	m_imageDisplay = new wxImagePanel(m_panelMain);
 	m_imageDisplay->Hide();
 	m_imageData = nullptr;
-	m_currentContainer = nullptr;
+	m_progress = nullptr;
+	m_scanProgress = nullptr;
 
 	m_infoText = new wxStaticText(
 		m_panelMain,
@@ -101,26 +141,26 @@ LVLExplorerFrame::LVLExplorerFrame() : wxFrame(
 	m_rightHandSideFlags = wxSizerFlags().Expand().Proportion(2).Border(wxTOP | wxRIGHT | wxBOTTOM, 10);
 	m_displayStatus = EDisplayStatus::NONE;
 	DisplayText();
+
+	// only wakes up the UI thread, results are picked up in OnIdle
+	m_previewWorker.Start([]() { wxWakeUpIdle(); });
 }
 
 LVLExplorerFrame::~LVLExplorerFrame()
 {
+	m_loadTimer.Stop();
+	m_scanTimer.Stop();
+	m_loader.Close();
+	m_previewWorker.Stop();
+
+	// do not wait for the whole folder when closing during a scan
+	m_assetIndex.CancelScan();
+
 	if (m_imageData != nullptr)
 	{
 		free(m_imageData);
 		m_imageData = nullptr;
 	}
-
-	DestroyLibContainer();
-}
-
-void LVLExplorerFrame::DestroyLibContainer()
-{
-	if (m_currentContainer == nullptr)
-		return;
-
-	Container::Delete(m_currentContainer);
-	m_currentContainer = nullptr;
 }
 
 void LVLExplorerFrame::DisplayText()
@@ -196,41 +236,290 @@ void LVLExplorerFrame::OnMenuOpenFile(wxCommandEvent& event)
 	if (dialog.ShowModal() == wxID_CANCEL)
 		return;
 
+	// the worker must not touch any chunk of the document we are about to close
+	m_previewWorker.CancelAndWait();
+	m_loader.Close();
+	m_loadTimer.Stop();
+
 	m_lvlTreeCtrl->DeleteAllItems();
-	m_treeToChunk.clear();
+	m_treeItems.clear();
+	m_topLevelItems.clear();
+	m_pendingRawItems.clear();
+	m_populatingTopLevel = ProgressiveLoader::NONE;
+	m_numPopulatedTopLevel = 0;
+	m_treeRoot = wxTreeItemId();
+	m_selectedItem = wxTreeItemId();
+
+	std::string error;
+	if (!m_document.Open(dialog.GetPath().ToStdString(), error))
+	{
+		wxMessageBox(error, "Error", wxICON_ERROR);
+		return;
+	}
+
+	// Show top level chunks right away and parse the rest in the background,
+	// while LibSWBF2 loads the file. Fall back to waiting for LibSWBF2 if the
+	// file cannot be streamed.
+	if (StartStreaming())
+		return;
+
+	wxASSERT(m_progress == nullptr);
+	m_progress = new wxProgressDialog("Loading", "Loading....");
+	m_progress->Show();
+}
+
+bool LVLExplorerFrame::StartStreaming()
+{
+	std::string error;
+	if (!m_loader.Open(m_document.GetPath(), error))
+	{
+		AddLogLine(wxString::Format("Streaming not possible, loading whole file: %s", error));
+		return false;
+	}
+
+	m_lvlTreeCtrl->Freeze();
+	m_treeRoot = m_lvlTreeCtrl->AddRoot("root");
+
+	const RawChunk& root = m_loader.GetRoot();
+	wxTreeItemId rootChunkItem = AppendChunkItem(m_treeRoot, wxString::Format("[0] %s", root.GetHeaderName()), {
+		root.GetHeaderName(),
+		(size_t)root.m_position,
+		(size_t)root.m_dataSize,
+		(size_t)root.GetFullSize()
+	});
 
-	if (m_currentContainer != nullptr)
+	const vector<RawChunk>& topLevel = m_loader.GetTopLevelChunks();
+	for (size_t i = 0; i < topLevel.size(); ++i)
 	{
-		DestroyLibContainer();
+		TreeItemInfo info = {
+			topLevel[i].GetHeaderName(),
+			(size_t)topLevel[i].m_position,
+			(size_t)topLevel[i].m_dataSize,
+			(size_t)topLevel[i].GetFullSize()
+		};
+		info.m_topLevelIndex = i;
+
+		wxTreeItemId item = AppendChunkItem(rootChunkItem, wxString::Format("[%i] %s (%u bytes)", (int)i, info.m_headerName, (uint32_t)info.m_fullSize), info);
+
+		// placeholder, so the item can be expanded before its children are known
+		if (topLevel[i].m_dataSize >= LVLExplorerCore::CHUNK_HEADER_SIZE)
+		{
+			m_lvlTreeCtrl->AppendItem(item, "Parsing...");
+		}
+		m_topLevelItems.push_back(item);
 	}
-	m_currentContainer = Container::Create();
 
-	wxString path = dialog.GetPath();
-	wxFileName fileName(path);
-	wxString fileExt = fileName.GetExt().Lower();
+	m_lvlTreeCtrl->Expand(m_treeRoot);
+	m_lvlTreeCtrl->Expand(rootChunkItem);
+	m_lvlTreeCtrl->Thaw();
+	m_lvlTreeCtrl->SetFocus();
+
+	m_loader.Start([]() { wxWakeUpIdle(); });
+
+	// nobody tells us when LibSWBF2 is done, check regularly
+	m_loadTimer.Start(100);
+	return true;
+}
+
+wxTreeItemId LVLExplorerFrame::AppendChunkItem(wxTreeItemId parent, const wxString& text, const TreeItemInfo& info)
+{
+	wxTreeItemId item = m_lvlTreeCtrl->AppendItem(parent, text);
+	m_lvlTreeCtrl->SetItemBackgroundColour(item, ITEM_COLOR_BACKGROUND);
+	m_lvlTreeCtrl->SetItemTextColour(item, ITEM_COLOR);
+	m_treeItems.emplace(item, info);
+	return item;
+}
 
-	if (fileExt == "lvl" || fileExt == "zafbin" || fileExt == "zaabin" || fileExt == "script")
+void LVLExplorerFrame::PopulateTopLevelItem(size_t topLevelIndex)
+{
+	wxTreeItemId item = m_topLevelItems[topLevelIndex];
+	const RawSubtree& subtree = m_loader.GetSubtree(topLevelIndex);
+	const vector<size_t>& children = subtree.m_nodes[0].m_children;
+
+	// Items are appended by AppendNextRawChunk() in time slices, so one huge
+	// subtree (e.g. a sub level) does not block the UI. The placeholder stays
+	// until the whole subtree has been added.
+	m_populatingTopLevel = topLevelIndex;
+	for (size_t i = children.size(); i-- > 0;)
 	{
-		m_currentContainer->AddLevel(path.c_str().AsChar());
+		m_pendingRawItems.push_back({ children[i], item });
 	}
-	else if (fileExt == "bnk")
+
+	if (m_pendingRawItems.empty())
 	{
-		m_currentContainer->AddSoundBank(path.c_str().AsChar());
+		FinishTopLevelItem();
 	}
-	else
+}
+
+void LVLExplorerFrame::AppendNextRawChunk()
+{
+	PendingRawItem pending = m_pendingRawItems.back();
+	m_pendingRawItems.pop_back();
+
+	const RawSubtree& subtree = m_loader.GetSubtree(m_populatingTopLevel);
+	const RawNode& node = subtree.m_nodes[pending.m_nodeIndex];
+	wxTreeItemId current = AppendChunkItem(pending.m_parent, wxString::Format("[%i] %s", (int)node.m_childIndex, node.m_chunk.GetHeaderName()), {
+		node.m_chunk.GetHeaderName(),
+		(size_t)node.m_chunk.m_position,
+		(size_t)node.m_chunk.m_dataSize,
+		(size_t)node.m_chunk.GetFullSize()
+	});
+
+	// pushed in reverse, so items get appended in file order
+	for (size_t i = node.m_children.size(); i-- > 0;)
 	{
-		wxMessageBox(
-			wxString::Format("Unknown file extension '%s'!", fileExt),
-			"Error",
-			wxICON_ERROR);
+		m_pendingRawItems.push_back({ node.m_children[i], current });
+	}
+
+	if (m_pendingRawItems.empty())
+	{
+		FinishTopLevelItem();
+	}
+}
+
+void LVLExplorerFrame::FinishTopLevelItem()
+{
+	RemovePlaceholder(m_topLevelItems[m_populatingTopLevel]);
+	m_populatingTopLevel = ProgressiveLoader::NONE;
+	++m_numPopulatedTopLevel;
+}
+
+bool LVLExplorerFrame::IsTreeViewComplete() const
+{
+	return m_numPopulatedTopLevel == m_topLevelItems.size();
+}
+
+void LVLExplorerFrame::RemovePlaceholder(wxTreeItemId item)
+{
+	wxTreeItemIdValue cookie;
+	wxTreeItemId placeholder = m_lvlTreeCtrl->GetFirstChild(item, cookie);
+	if (!placeholder.IsOk() || m_treeItems.find(placeholder) != m_treeItems.end())
 		return;
+
+	// the id of a deleted item may be reused for a new one, don't keep it around
+	if (placeholder == m_selectedItem)
+	{
+		m_selectedItem = wxTreeItemId();
 	}
+	m_lvlTreeCtrl->Delete(placeholder);
+}
 
-	wxASSERT(m_progress == nullptr);
-	m_progress = new wxProgressDialog("Loading", "Loading....");
-	m_progress->Show();
-	
-	m_currentContainer->StartLoading();
+size_t LVLExplorerFrame::ResolveNode(TreeItemInfo& info)
+{
+	if (info.m_nodeIndex == ChunkTree::NONE && !m_document.IsLoading())
+	{
+		info.m_nodeIndex = m_document.GetTree().FindNode(info.m_position, info.m_headerName);
+	}
+	return info.m_nodeIndex;
+}
+
+wxString LVLExplorerFrame::GetAssetIndexPath(const wxString& directory)
+{
+	// keep indices out of the (possibly read only) game directory
+	wxString indexDir = wxStandardPaths::Get().GetUserDataDir();
+	wxFileName::Mkdir(indexDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+
+	size_t hash = std::hash<std::string>()(directory.ToStdString());
+	return wxFileName(indexDir, wxString::Format("index_%llx.txt", (unsigned long long)hash)).GetFullPath();
+}
+
+void LVLExplorerFrame::OnMenuScanFolder(wxCommandEvent& event)
+{
+	if (m_assetIndex.IsScanning())
+		return;
+
+	wxDirDialog dialog(this, "Select game data folder to index", "", wxDD_DEFAULT_STYLE | wxDD_DIR_MUST_EXIST);
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	wxString directory = dialog.GetPath();
+	m_assetIndexPath = GetAssetIndexPath(directory);
+
+	// load the previous index of that folder, so only changed files get parsed again
+	if (!m_assetIndex.Load(m_assetIndexPath.ToStdString()) || m_assetIndex.GetDirectory() != directory.ToStdString())
+	{
+		m_assetIndex.Clear();
+	}
+
+	std::string error;
+	if (!m_assetIndex.StartScan(directory.ToStdString(), error))
+	{
+		wxMessageBox(error, "Error", wxICON_ERROR);
+		return;
+	}
+
+	wxASSERT(m_scanProgress == nullptr);
+	m_scanProgress = new wxProgressDialog("Scanning", "Scanning....", 100, this, wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT);
+	m_scanProgress->Show();
+	m_scanTimer.Start(100);
+}
+
+void LVLExplorerFrame::OnMenuFindAsset(wxCommandEvent& event)
+{
+	if (m_assetIndex.IsScanning())
+		return;
+
+	// continue with the index of the previous session
+	wxString lastIndexPath;
+	if (m_assetIndex.GetFiles().empty() && wxConfigBase::Get()->Read(CONFIG_LAST_ASSET_INDEX, &lastIndexPath))
+	{
+		if (m_assetIndex.Load(lastIndexPath.ToStdString()))
+		{
+			m_assetIndexPath = lastIndexPath;
+			AddLogLine(wxString::Format("Loaded asset index of '%s'", m_assetIndex.GetDirectory()));
+		}
+		else
+		{
+			AddLogLine(wxString::Format("Could not read asset index '%s'!", lastIndexPath));
+		}
+	}
+
+	if (m_assetIndex.GetFiles().empty())
+	{
+		wxMessageBox("No folder has been scanned yet! Use 'Scan Folder...' first.", "Find Asset", wxICON_INFORMATION);
+		return;
+	}
+
+	wxDialog dialog(this, wxID_ANY, "Find Asset in Index");
+	wxTextCtrl* nameCtrl = new wxTextCtrl(&dialog, wxID_ANY);
+	wxTextCtrl* typeCtrl = new wxTextCtrl(&dialog, wxID_ANY);
+	typeCtrl->SetHint("any, e.g. tex_");
+
+	wxFlexGridSizer* fields = new wxFlexGridSizer(2, 5, 5);
+	fields->AddGrowableCol(1);
+	fields->Add(new wxStaticText(&dialog, wxID_ANY, "Asset name:"), 0, wxALIGN_CENTER_VERTICAL);
+	fields->Add(nameCtrl, 1, wxEXPAND);
+	fields->Add(new wxStaticText(&dialog, wxID_ANY, "Chunk type:"), 0, wxALIGN_CENTER_VERTICAL);
+	fields->Add(typeCtrl, 1, wxEXPAND);
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->Add(fields, 1, wxEXPAND | wxALL, 10);
+	sizer->Add(dialog.CreateStdDialogButtonSizer(wxOK | wxCANCEL), 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
+	dialog.SetSizerAndFit(sizer);
+	dialog.SetSize(wxSize(400, -1));
+	nameCtrl->SetFocus();
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	wxString name = nameCtrl->GetValue().Trim().Trim(false);
+	wxString type = typeCtrl->GetValue().Trim().Trim(false);
+	vector<AssetIndexEntry> entries = m_assetIndex.Find(name.ToStdString(), type.ToStdString());
+
+	m_textDisplay->Clear();
+	m_textDisplay->AppendText(wxString::Format("Found '%s' %i time(s):\n", name, (int)entries.size()));
+	for (const AssetIndexEntry& entry : entries)
+	{
+		m_textDisplay->AppendText(wxString::Format(
+			"%s\t%s\tPosition: %llu\tSize: %llu\t%s\n",
+			entry.m_asset->m_type,
+			entry.m_asset->m_name,
+			(unsigned long long)entry.m_asset->m_position,
+			(unsigned long long)entry.m_asset->m_size,
+			entry.m_file->m_path
+		));
+	}
+	DisplayText();
 }
 
 void LVLExplorerFrame::OnMenuExit(wxCommandEvent& event)
@@ -238,11 +527,157 @@ void LVLExplorerFrame::OnMenuExit(wxCommandEvent& event)
 	Close();
 }
 
+vector<LVLExplorerFrame::TreeItemInfo> LVLExplorerFrame::GetSelectedItems()
+{
+	vector<TreeItemInfo> items;
+
+	wxArrayTreeItemIds selection;
+	m_lvlTreeCtrl->GetSelections(selection);
+	for (const wxTreeItemId& item : selection)
+	{
+		auto it = m_treeItems.find(item);
+		if (it != m_treeItems.end())
+		{
+			items.push_back(it->second);
+		}
+	}
+	return items;
+}
+
+void LVLExplorerFrame::OnMenuExtractChunks(wxCommandEvent& event)
+{
+	vector<TreeItemInfo> items = GetSelectedItems();
+	if (items.empty())
+	{
+		wxMessageBox("No chunks selected!", "Extract", wxICON_INFORMATION);
+		return;
+	}
+
+	vector<wxString> targetPaths;
+	if (items.size() == 1)
+	{
+		const TreeItemInfo& info = items[0];
+		wxFileDialog dialog(this, "Extract chunk", "", ChunkExtractor::MakeChunkFileName(info.m_headerName, info.m_position),
+			"Chunk (*.chunk)|*.chunk|All files (*.*)|*.*", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+		if (dialog.ShowModal() == wxID_CANCEL)
+			return;
+
+		targetPaths.push_back(dialog.GetPath());
+	}
+	else
+	{
+		wxDirDialog dialog(this, wxString::Format("Extract %i chunks to", (int)items.size()), "", wxDD_DEFAULT_STYLE);
+		if (dialog.ShowModal() == wxID_CANCEL)
+			return;
+
+		for (const TreeItemInfo& info : items)
+		{
+			targetPaths.push_back(wxFileName(dialog.GetPath(), ChunkExtractor::MakeChunkFileName(info.m_headerName, info.m_position)).GetFullPath());
+		}
+	}
+
+	ChunkExtractor extractor;
+	std::string error;
+	if (!extractor.Open(m_document.GetPath(), error))
+	{
+		wxMessageBox(error, "Error", wxICON_ERROR);
+		return;
+	}
+
+	wxProgressDialog progress("Extracting", "Extracting....", (int)items.size(), this, wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT);
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		if (!extractor.ExtractChunk({ items[i].m_position, items[i].m_fullSize }, targetPaths[i].ToStdString(), error))
+		{
+			wxMessageBox(error, "Error", wxICON_ERROR);
+			return;
+		}
+
+		if (!progress.Update((int)i + 1, targetPaths[i]))
+			return;
+	}
+}
+
+void LVLExplorerFrame::OnMenuExtractContainer(wxCommandEvent& event)
+{
+	vector<TreeItemInfo> items = GetSelectedItems();
+	if (items.empty())
+	{
+		wxMessageBox("No chunks selected!", "Extract", wxICON_INFORMATION);
+		return;
+	}
+
+	wxFileDialog dialog(this, "Extract chunks as container", "", "extracted.lvl",
+		"SWBF2 Level (*.lvl)|*.lvl|All files (*.*)|*.*", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	vector<ChunkRange> chunks;
+	for (const TreeItemInfo& info : items)
+	{
+		chunks.push_back({ info.m_position, info.m_fullSize });
+	}
+	ChunkExtractor::RemoveNestedRanges(chunks);
+
+	ChunkExtractor extractor;
+	std::string error;
+	if (!extractor.Open(m_document.GetPath(), error) || !extractor.ExtractContainer(chunks, dialog.GetPath().ToStdString(), error))
+	{
+		wxMessageBox(error, "Error", wxICON_ERROR);
+		return;
+	}
+
+	AddLogLine(wxString::Format("Extracted %i chunks into '%s'", (int)chunks.size(), dialog.GetPath()));
+}
+
+void LVLExplorerFrame::OnMenuStatistics(wxCommandEvent& event)
+{
+	if (m_document.GetTree().IsEmpty())
+	{
+		wxMessageBox(m_document.IsLoading() ? "File is still loading!" : "No file loaded!", "Statistics", wxICON_INFORMATION);
+		return;
+	}
+
+	StatisticsDialog dialog(this, m_document.GetTree(), m_document.GetPath());
+	dialog.ShowModal();
+}
+
 void LVLExplorerFrame::OnTreeSelectionChanges(wxTreeEvent& event)
 {
 	wxTreeItemId item = event.GetItem();
-	if (item == m_treeRoot)
+
+	// in multi selection mode, deselecting may not deliver an item
+	if (!item.IsOk())
+		return;
+
+	m_selectedItem = item;
+	ShowItem(item);
+}
+
+void LVLExplorerFrame::OnTreeItemExpanding(wxTreeEvent& event)
+{
+	auto it = m_treeItems.find(event.GetItem());
+	if (it != m_treeItems.end() && it->second.m_topLevelIndex != ProgressiveLoader::NONE)
 	{
+		m_loader.Prioritize(it->second.m_topLevelIndex);
+	}
+}
+
+void LVLExplorerFrame::OnPollTimer(wxTimerEvent& event)
+{
+	// just make sure OnIdle gets to check the loading and scanning state
+	wxWakeUpIdle();
+}
+
+void LVLExplorerFrame::ShowItem(wxTreeItemId item)
+{
+	// root, or placeholder of a subtree that is still being parsed
+	auto it = m_treeItems.find(item);
+	if (it == m_treeItems.end())
+	{
+		m_previewWorker.Cancel();
 		m_infoText->SetLabel(
 			"Chunk Position:\n"
 			"Chunk Data Size:\n"
@@ -251,60 +686,52 @@ void LVLExplorerFrame::OnTreeSelectionChanges(wxTreeEvent& event)
 		return;
 	}
 
-	auto it = m_treeToChunk.find(item);
-	if (it == m_treeToChunk.end())
-	{
-		wxLogError("Could not find corresponding chunk for tree item ID %i!", item.GetID());
-		return;
-	}
-
-	const GenericBaseChunk* chunk = it->second;
+	TreeItemInfo& info = it->second;
 	m_infoText->SetLabel(wxString::Format(
 		"Chunk Position:\t%i\n"
 		"Chunk Data Size:\t%i\n"
 		"Chunk Full Size:\t%i",
-		(uint32_t)chunk->GetPosition(),
-		(uint32_t)chunk->GetDataSize(),
-		(uint32_t)chunk->GetFullSize()
+		(uint32_t)info.m_position,
+		(uint32_t)info.m_dataSize,
+		(uint32_t)info.m_fullSize
 	));
 
-	const BODY* textureBodyChunk = dynamic_cast<const BODY*>(chunk);
-
-	// Display first mip map texture of first found format if a tex_ chunk is selected
-	const tex_* textureChunk = dynamic_cast<const tex_*>(chunk);
-	if (textureChunk != nullptr && textureChunk->m_FMTs.Size() > 0 && textureChunk->m_FMTs[0]->p_Face->m_LVLs.Size() > 0)
+	if (info.m_topLevelIndex != ProgressiveLoader::NONE)
 	{
-		textureBodyChunk = textureChunk->m_FMTs[0]->p_Face->m_LVLs[0]->p_Body;
+		m_loader.Prioritize(info.m_topLevelIndex);
 	}
 
-	if (textureBodyChunk != nullptr)
+	size_t nodeIndex = ResolveNode(info);
+	if (nodeIndex == ChunkTree::NONE)
 	{
-		const uint8_t* data;
+		m_previewWorker.Cancel();
+		m_textDisplay->Clear();
+		m_textDisplay->WriteText(m_document.IsLoading() ?
+			"Still loading, the preview will show up once the file has been fully parsed..." :
+			"No preview available, LibSWBF2 did not parse this chunk.");
+		DisplayText();
+		return;
+	}
 
-		// this delivers R8 G8 B8 A8
-		textureBodyChunk->GetImageData(ETextureFormat::R8_G8_B8_A8, m_imageWidth, m_imageHeight, data);
+	// Text or texture preview may take a while, let the worker do it.
+	// Selecting something else in the meantime cancels this request.
+	m_previewWorker.Request(nodeIndex, m_document.GetTree().GetNode(nodeIndex).m_chunk);
+}
 
-		m_textDisplay->AppendText(wxString::Format("grabbed image data at: %i\n", (int)(size_t)data));
-		m_textDisplay->AppendText(wxString::Format("chunk position: %i\n", (int)(size_t)textureBodyChunk->GetPosition()));
+void LVLExplorerFrame::DisplayPreview(const PreviewResult& result)
+{
+	if (result.m_type == EPreviewType::IMAGE)
+	{
+		m_imageWidth = result.m_width;
+		m_imageHeight = result.m_height;
 
-		size_t numPixels = m_imageWidth * m_imageHeight;
 		if (m_imageData != nullptr)
 		{
 			free(m_imageData);
 		}
 
-		m_imageData = (uint8_t*)malloc(numPixels * 3);
-		for (size_t i = 0; i < numPixels; ++i)
-		{
-			// calc alpha
-			const uint8_t alphaColor[3] = { 255, 0, 255 };
-			float alpha = data[(i * 4) + 3] / 255.f;
-			float transparency = 1.f - alpha;
-
-			m_imageData[(i * 3) + 0] = uint8_t(data[(i * 4) + 0] * alpha + alphaColor[0] * transparency);
-			m_imageData[(i * 3) + 1] = uint8_t(data[(i * 4) + 1] * alpha + alphaColor[1] * transparency);
-			m_imageData[(i * 3) + 2] = uint8_t(data[(i * 4) + 2] * alpha + alphaColor[2] * transparency);
-		}
+		m_imageData = (uint8_t*)malloc(result.m_rgb.size());
+		memcpy(m_imageData, result.m_rgb.data(), result.m_rgb.size());
 
 		m_imageDisplay->SetImageData(m_imageWidth, m_imageHeight, m_imageData);
 		DisplayImage();
@@ -324,48 +751,39 @@ void LVLExplorerFrame::OnTreeSelectionChanges(wxTreeEvent& event)
 			grow = grow > 0 ? -1 : 1;
 		}
 	}
-	else
+	else if (result.m_type == EPreviewType::TEXT)
 	{
 		m_textDisplay->Clear();
-		m_textDisplay->WriteText(chunk->ToString().Buffer());
+		m_textDisplay->WriteText(result.m_text);
 		DisplayText();
 	}
 }
 
-bool LVLExplorerFrame::SearchTree(wxTreeItemId parent, const wxString& search)
+bool LVLExplorerFrame::ApplySearchResults(wxTreeItemId parent)
 {
 	wxTreeItemIdValue cookie;
 	wxTreeItemId next = m_lvlTreeCtrl->GetFirstChild(parent, cookie);
 	bool bFoundInChildren = false;
 	while (next.IsOk())
 	{
-		bFoundInChildren = SearchTree(next, search) || bFoundInChildren;
+		bFoundInChildren = ApplySearchResults(next) || bFoundInChildren;
 		next = m_lvlTreeCtrl->GetNextChild(parent, cookie);
 	}
 
-	if (search.IsEmpty())
-		return false;
-
-
+	bool bFound = false;
 	bool bFoundInInfo = false;
-	auto it = m_treeToChunk.find(parent);
-	if (it != m_treeToChunk.end())
+	auto it = m_treeItems.find(parent);
+	if (it != m_treeItems.end() && ResolveNode(it->second) != ChunkTree::NONE)
 	{
-		const GenericBaseChunk* chunk = it->second;
-		try
-		{
-			// sometimes, someone (not LibSWBF2) throws a "string too long" exception (msvcp140d.dll??)
-			// I'm too lazy right now to dive depp into that... just ignore that chunk... TODO
-			bFoundInInfo = wxString(chunk->ToString().Buffer()).Contains(search);
-		}
-		catch (std::exception& e)
-		{
-			//m_textDisplay->AppendText(e.what());
-			bFoundInInfo = false;
-		}
+		const SearchMatch& match = m_searchMatches[it->second.m_nodeIndex];
+		bFound = match.IsFound();
+		bFoundInInfo = match.m_foundInInfo;
+
+		// while streaming, the tree view comes from the raw parser, which may
+		// not have an item for every chunk of the LibSWBF2 chunk graph
+		bFoundInChildren = bFoundInChildren || match.m_foundInChildren;
 	}
 
-	bool bFound = bFoundInInfo || m_lvlTreeCtrl->GetItemText(parent).Contains(search);
 	if (bFound && !bFoundInChildren)
 	{
 		m_lvlTreeCtrl->SetItemBackgroundColour(parent, ITEM_COLOR_FOUND_BACKGROUND);
@@ -391,7 +809,7 @@ bool LVLExplorerFrame::SearchTree(wxTreeItemId parent, const wxString& search)
 		m_lvlTreeCtrl->Collapse(parent);
 	}
 	return bFound || bFoundInChildren;
-};
+}
 
 void LVLExplorerFrame::OnSearch(wxCommandEvent& event)
 {
@@ -400,23 +818,37 @@ void LVLExplorerFrame::OnSearch(wxCommandEvent& event)
 		return;
 	}
 
+	// an empty search matches nothing, which resets all highlights
 	wxString search = event.GetString();
-	SearchTree(m_treeRoot, search);
-}
 
-void LVLExplorerFrame::ParseChunk(const GenericBaseChunk* chunk, wxTreeItemId parent, size_t childIndex)
-{
-	wxTreeItemId current = m_lvlTreeCtrl->AppendItem(parent, wxString::Format("[%i] %s", (int)childIndex, chunk->GetHeaderName().Buffer()));
-	m_lvlTreeCtrl->SetItemBackgroundColour(current, ITEM_COLOR_BACKGROUND);
-	m_lvlTreeCtrl->SetItemTextColour(current, ITEM_COLOR);
-	m_treeToChunk.emplace(current, chunk);
+	// searching needs the info texts (LibSWBF2) and every chunk in the tree view
+	if (!search.IsEmpty() && (m_document.IsLoading() || !IsTreeViewComplete()))
+	{
+		wxMessageBox("File is still loading, please search again once it has finished!", "Search", wxICON_INFORMATION);
+		return;
+	}
 
-	//m_chunkNames += chunk->GetHeaderName().Buffer() + wxString("\n");
+	LVLExplorerCore::SearchChunkTree(m_document.GetTree(), search.ToStdString(), m_searchMatches);
+	ApplySearchResults(m_treeRoot);
+}
 
-	const List<GenericBaseChunk*>& children = chunk->GetChildren();
-	for (size_t i = 0; i < children.Size(); ++i)
+void LVLExplorerFrame::ParseChunk(size_t nodeIndex, wxTreeItemId parent)
+{
+	const ChunkTree& tree = m_document.GetTree();
+	const ChunkNode& node = tree.GetNode(nodeIndex);
+
+	TreeItemInfo info = {
+		node.m_headerName,
+		node.m_position,
+		node.m_dataSize,
+		node.m_fullSize
+	};
+	info.m_nodeIndex = nodeIndex;
+	wxTreeItemId current = AppendChunkItem(parent, tree.GetDisplayName(nodeIndex), info);
+
+	for (size_t child : node.m_children)
 	{
-		ParseChunk(children[i], current, i);
+		ParseChunk(child, current);
 	}
 }
 
@@ -428,18 +860,30 @@ void LVLExplorerFrame::OnIdle(wxIdleEvent& event)
 		AddLogLine(log.ToString().Buffer());
 	}
 
-	if (m_currentContainer != nullptr && m_progress != nullptr)
+	PreviewResult preview;
+	if (m_previewWorker.TakeResult(preview))
 	{
-		if (!m_currentContainer->IsDone())
+		DisplayPreview(preview);
+	}
+
+	if (m_document.IsLoading() && m_progress != nullptr)
+	{
+		if (!m_document.IsDone())
 		{
-			int percent = int(m_currentContainer->GetOverallProgress() * 100.0f);
+			int percent = int(m_document.GetProgress() * 100.0f);
 			wxString dspStr = wxString::Format("Loading... %d %%", percent);
 			m_progress->Update(percent, dspStr);
 		}
 		else
 		{
-			List<SWBF2Handle> handles = m_currentContainer->GetLoadedLevels();
-			Level* level = m_currentContainer->GetLevel(handles[0]);
+			std::string error;
+			if (!m_document.FinishLoading(error))
+			{
+				delete m_progress;
+				m_progress = nullptr;
+				wxMessageBox(error, "Error", wxICON_ERROR);
+				return;
+			}
 
 			m_lvlTreeCtrl->Freeze();
 			//m_treeRoot = m_lvlTreeCtrl->AddRoot(level->GetLevelName().Buffer());
@@ -447,7 +891,7 @@ void LVLExplorerFrame::OnIdle(wxIdleEvent& event)
 			m_lvlTreeCtrl->Thaw();
 
 			m_progress->Update(100, "Parsing...");
-			ParseChunk(level->GetChunk(), m_treeRoot);
+			ParseChunk(m_document.GetTree().GetRoot(), m_treeRoot);
 
 			m_lvlTreeCtrl->Expand(m_treeRoot);
 
@@ -458,6 +902,112 @@ void LVLExplorerFrame::OnIdle(wxIdleEvent& event)
 			m_lvlTreeCtrl->SetFocus();
 		}
 	}
+
+	if (m_loader.IsOpen())
+	{
+		// add parsed subtrees to the tree view, without blocking the UI for too long
+		auto start = std::chrono::steady_clock::now();
+		auto budget = std::chrono::milliseconds(STREAMING_IDLE_BUDGET_MS);
+		bool bBudgetExceeded = false;
+		bool bFrozen = false;
+		while (!(bBudgetExceeded = std::chrono::steady_clock::now() - start > budget))
+		{
+			// finish the current subtree before starting with the next one
+			size_t topLevelIndex = ProgressiveLoader::NONE;
+			if (m_pendingRawItems.empty() && !m_loader.TakeParsedSubtree(topLevelIndex))
+				break;
+
+			if (!bFrozen)
+			{
+				m_lvlTreeCtrl->Freeze();
+				bFrozen = true;
+			}
+
+			if (topLevelIndex != ProgressiveLoader::NONE)
+			{
+				PopulateTopLevelItem(topLevelIndex);
+			}
+			else
+			{
+				AppendNextRawChunk();
+			}
+		}
+		if (bFrozen)
+		{
+			m_lvlTreeCtrl->Thaw();
+		}
+		if (bBudgetExceeded)
+		{
+			event.RequestMore();
+		}
+
+		// LibSWBF2 has finished in the background, previews and search are available now
+		if (m_document.IsLoading() && m_document.IsDone())
+		{
+			m_loadTimer.Stop();
+
+			std::string error;
+			if (!m_document.FinishLoading(error))
+			{
+				wxMessageBox(error, "Error", wxICON_ERROR);
+			}
+			else
+			{
+				AddLogLine(wxString::Format("Finished loading '%s'", m_document.GetPath()));
+			}
+
+			if (m_selectedItem.IsOk())
+			{
+				ShowItem(m_selectedItem);
+			}
+		}
+	}
+
+	if (m_scanProgress != nullptr)
+	{
+		if (!m_assetIndex.IsDone())
+		{
+			int percent = int(m_assetIndex.GetProgress() * 100.0f);
+			wxString dspStr = wxString::Format("Scanning... %d %%", percent);
+			if (!m_scanProgress->Update(percent, dspStr))
+			{
+				m_assetIndex.CancelScan();
+			}
+		}
+		else
+		{
+			m_scanTimer.Stop();
+			m_assetIndex.WaitUntilDone();
+			bool bCancelled = m_scanProgress->WasCancelled();
+			delete m_scanProgress;
+			m_scanProgress = nullptr;
+
+			if (bCancelled)
+			{
+				AddLogLine(m_assetIndex.GetScanError());
+				return;
+			}
+			if (!m_assetIndex.GetScanError().empty())
+			{
+				wxMessageBox(m_assetIndex.GetScanError(), "Error", wxICON_ERROR);
+				return;
+			}
+
+			if (!m_assetIndex.Save(m_assetIndexPath.ToStdString()))
+			{
+				AddLogLine(wxString::Format("Could not write asset index '%s'!", m_assetIndexPath));
+			}
+			else
+			{
+				wxConfigBase::Get()->Write(CONFIG_LAST_ASSET_INDEX, m_assetIndexPath);
+			}
+
+			AddLogLine(wxString::Format("Indexed %i files (%i parsed) in '%s'",
+				(int)m_assetIndex.GetFiles().size(),
+				(int)m_assetIndex.GetNumParsedFiles(),
+				m_assetIndex.GetDirectory()));
+		}
+	}
 }
 
 void LVLExplorerFrame::AddLogLine(wxString msg)
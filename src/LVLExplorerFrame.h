@@ -8,26 +8,38 @@
 #include <wx/treectrl.h>
 #include <wx/stattext.h>
 #include <wx/progdlg.h>
+#include <wx/timer.h>
+#include <vector>
 #include "wxImagePanel.h"
 #include "LibSWBF2.h"
-#include "Chunks/LVL/tex_/tex_.h"
-#include "Chunks/LVL/tex_/BODY.h"
+#include "Core/Document.h"
+#include "Core/ChunkSearch.h"
+#include "Core/AssetIndex.h"
+#include "Core/ChunkExtractor.h"
+#include "Core/PreviewWorker.h"
+#include "Core/ProgressiveLoader.h"
 
 using std::map;
-using LibSWBF2::Chunks::LVL::LVL;
-using LibSWBF2::Chunks::BNK::BNK;
-using LibSWBF2::Chunks::LVL::texture::tex_;
-using LibSWBF2::Chunks::LVL::LVL_texture::BODY;
+using std::vector;
 using LibSWBF2::Chunks::GenericBaseChunk;
-using LibSWBF2::Types::List;
-using LibSWBF2::ETextureFormat;
 using LibSWBF2::ELogType;
-using LibSWBF2::ELoadStatus;
-using LibSWBF2::Container;
-using LibSWBF2::SWBF2Handle;
-using LibSWBF2::Wrappers::Level;
 using LibSWBF2::Logging::Logger;
 using LibSWBF2::Logging::LoggerEntry;
+using LVLExplorerCore::Document;
+using LVLExplorerCore::ChunkTree;
+using LVLExplorerCore::ChunkNode;
+using LVLExplorerCore::SearchMatch;
+using LVLExplorerCore::AssetIndex;
+using LVLExplorerCore::AssetIndexEntry;
+using LVLExplorerCore::ChunkExtractor;
+using LVLExplorerCore::ChunkRange;
+using LVLExplorerCore::PreviewWorker;
+using LVLExplorerCore::PreviewResult;
+using LVLExplorerCore::EPreviewType;
+using LVLExplorerCore::ProgressiveLoader;
+using LVLExplorerCore::RawChunk;
+using LVLExplorerCore::RawSubtree;
+using LVLExplorerCore::RawNode;
 
 class LVLExplorerFrame : public wxFrame
 {
@@ -50,12 +62,39 @@ private:
 	const wxColor ITEM_COLOR_FOUND_BACKGROUND = wxColor(32, 32, 32);
 	const wxColor ITEM_COLOR_FOUND_CHILDREN = wxColor(220, 220, 0);
 
+	// Everything known about a chunk in the tree view. While a file is still
+	// being loaded, this only holds raw header information.
+	struct TreeItemInfo
+	{
+		std::string m_headerName;
+		size_t m_position;
+		size_t m_dataSize;
+		size_t m_fullSize;
+
+		// only set for top level chunks while streaming
+		size_t m_topLevelIndex = ProgressiveLoader::NONE;
+
+		// into m_document's ChunkTree, NONE until LibSWBF2 has finished loading
+		size_t m_nodeIndex = ChunkTree::NONE;
+	};
+
+	// raw chunk of the subtree currently being added to the tree view
+	struct PendingRawItem
+	{
+		size_t m_nodeIndex;
+		wxTreeItemId m_parent;
+	};
+
 private:
 	//wxTimer m_timer;
+	wxTimer m_loadTimer;
+	wxTimer m_scanTimer;
 	wxProgressDialog* m_progress;
+	wxProgressDialog* m_scanProgress;
 
 	wxMenuBar* m_menuMain;
 	wxMenu* m_fileMenu;
+	wxMenu* m_chunkMenu;
 	wxPanel* m_panelMain;
 	wxBoxSizer* m_sizerLeft;
 	wxBoxSizer* m_sizerHorizontal;
@@ -70,8 +109,22 @@ private:
 	wxSizerFlags m_rightHandSideFlags;
 	EDisplayStatus m_displayStatus;
 
-	Container* m_currentContainer;
-	map<wxTreeItemId, const GenericBaseChunk*> m_treeToChunk;
+	Document m_document;
+	map<wxTreeItemId, TreeItemInfo> m_treeItems;
+	wxTreeItemId m_selectedItem;
+	vector<SearchMatch> m_searchMatches;
+
+	// declared after m_document, so it is stopped before the chunks it works on are destroyed
+	PreviewWorker m_previewWorker;
+
+	ProgressiveLoader m_loader;
+	vector<wxTreeItemId> m_topLevelItems;
+	vector<PendingRawItem> m_pendingRawItems;
+	size_t m_populatingTopLevel = ProgressiveLoader::NONE;
+	size_t m_numPopulatedTopLevel = 0;
+
+	AssetIndex m_assetIndex;
+	wxString m_assetIndexPath;
 
 	uint16_t m_imageWidth;
 	uint16_t m_imageHeight;
@@ -82,16 +135,34 @@ private:
 private:
 	void DisplayText();
 	void DisplayImage();
+	void DisplayPreview(const PreviewResult& result);
 	void HideCurrentDisplay();
-	void ParseChunk(const GenericBaseChunk* chunk, wxTreeItemId parent, size_t childIndex=0);
-	bool SearchTree(wxTreeItemId parent, const wxString& search);
-	void DestroyLibContainer();
+	void ParseChunk(size_t nodeIndex, wxTreeItemId parent);
+	bool StartStreaming();
+	wxTreeItemId AppendChunkItem(wxTreeItemId parent, const wxString& text, const TreeItemInfo& info);
+	void PopulateTopLevelItem(size_t topLevelIndex);
+	void AppendNextRawChunk();
+	void FinishTopLevelItem();
+	bool IsTreeViewComplete() const;
+	void RemovePlaceholder(wxTreeItemId item);
+	size_t ResolveNode(TreeItemInfo& info);
+	void ShowItem(wxTreeItemId item);
+	bool ApplySearchResults(wxTreeItemId parent);
 	void AddLogLine(wxString msg);
+	wxString GetAssetIndexPath(const wxString& directory);
+	vector<TreeItemInfo> GetSelectedItems();
 
 	// events
 	void OnMenuOpenFile(wxCommandEvent& event);
+	void OnMenuScanFolder(wxCommandEvent& event);
+	void OnMenuFindAsset(wxCommandEvent& event);
 	void OnMenuExit(wxCommandEvent& event);
+	void OnMenuExtractChunks(wxCommandEvent& event);
+	void OnMenuExtractContainer(wxCommandEvent& event);
+	void OnMenuStatistics(wxCommandEvent& event);
 	void OnTreeSelectionChanges(wxTreeEvent& event);
+	void OnTreeItemExpanding(wxTreeEvent& event);
+	void OnPollTimer(wxTimerEvent& event);
 	void OnSearch(wxCommandEvent& event);
 	void OnIdle(wxIdleEvent& event);
 
@@ -0,0 +1,238 @@
+#include "StatisticsDialog.h"
+#include <algorithm>
+#include <wx/dirdlg.h>
+#include <wx/msgdlg.h>
+#include <wx/sizer.h>
+#include <wx/stattext.h>
+#include <wx/utils.h>
+
+
+#define ID_TYPE_LIST 1200
+#define ID_ASSET_LIST 1201
+#define ID_EXPORT_CSV 1202
+
+wxBEGIN_EVENT_TABLE(StatisticsDialog, wxDialog)
+	EVT_LIST_COL_CLICK(ID_TYPE_LIST, StatisticsDialog::OnTypeColumnClick)
+	EVT_LIST_COL_CLICK(ID_ASSET_LIST, StatisticsDialog::OnAssetColumnClick)
+	EVT_BUTTON(ID_EXPORT_CSV, StatisticsDialog::OnExportCSV)
+wxEND_EVENT_TABLE()
+
+static wxString FormatBytes(uint64_t bytes, uint64_t total)
+{
+	double percent = total > 0 ? bytes * 100.0 / total : 0.0;
+	return wxString::Format("%llu (%.1f %%)", (unsigned long long)bytes, percent);
+}
+
+wxLayoutListCtrl::wxLayoutListCtrl(wxWindow* parent, const ChunkTree& tree, const vector<LayoutRegion>& layout) : wxListCtrl(
+	parent,
+	wxID_ANY,
+	wxDefaultPosition,
+	wxDefaultSize,
+	wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL),
+	m_tree(tree),
+	m_layout(layout)
+{
+	m_paddingAttr.SetBackgroundColour(wxColor(255, 255, 160));
+	m_gapAttr.SetBackgroundColour(wxColor(255, 160, 160));
+
+	AppendColumn("Start", wxLIST_FORMAT_RIGHT, 100);
+	AppendColumn("End", wxLIST_FORMAT_RIGHT, 100);
+	AppendColumn("Size", wxLIST_FORMAT_RIGHT, 80);
+	AppendColumn("Kind", wxLIST_FORMAT_LEFT, 70);
+	AppendColumn("Chunk", wxLIST_FORMAT_LEFT, 70);
+	SetItemCount((long)m_layout.size());
+}
+
+wxString wxLayoutListCtrl::OnGetItemText(long item, long column) const
+{
+	const LayoutRegion& region = m_layout[item];
+	switch (column)
+	{
+		case 0:
+			return wxString::Format("%llu", (unsigned long long)region.m_start);
+		case 1:
+			return wxString::Format("%llu", (unsigned long long)(region.m_start + region.m_size));
+		case 2:
+			return wxString::Format("%llu", (unsigned long long)region.m_size);
+		case 3:
+			return ChunkStatistics::LayoutRegionToString(region.m_kind);
+		case 4:
+			return m_tree.GetDisplayName(region.m_nodeIndex);
+		default:
+			return "";
+	}
+}
+
+wxListItemAttr* wxLayoutListCtrl::OnGetItemAttr(long item) const
+{
+	switch (m_layout[item].m_kind)
+	{
+		case ELayoutRegion::PADDING:
+			return const_cast<wxListItemAttr*>(&m_paddingAttr);
+		case ELayoutRegion::GAP:
+			return const_cast<wxListItemAttr*>(&m_gapAttr);
+		default:
+			return nullptr;
+	}
+}
+
+StatisticsDialog::StatisticsDialog(wxWindow* parent, const ChunkTree& tree, const wxString& sourcePath) : wxDialog(
+	parent,
+	wxID_ANY,
+	"Statistics - " + sourcePath,
+	wxDefaultPosition,
+	wxSize(800, 600),
+	wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER),
+	m_tree(tree)
+{
+	{
+		wxBusyCursor busy;
+		m_stats.Compute(m_tree, sourcePath.ToStdString());
+	}
+	m_types = m_stats.GetTypes();
+	m_assets = m_stats.GetAssets();
+
+	const uint64_t fileSize = m_stats.GetFileSize();
+	wxStaticText* summary = new wxStaticText(this, wxID_ANY, wxString::Format(
+		"File Size:\t%llu\n"
+		"Headers:\t%s\n"
+		"Data:\t\t%s\n"
+		"Padding:\t%s\n"
+		"Gaps:\t\t%s",
+		(unsigned long long)fileSize,
+		FormatBytes(m_stats.GetBytes(ELayoutRegion::HEADER), fileSize),
+		FormatBytes(m_stats.GetBytes(ELayoutRegion::DATA), fileSize),
+		FormatBytes(m_stats.GetBytes(ELayoutRegion::PADDING), fileSize),
+		FormatBytes(m_stats.GetBytes(ELayoutRegion::GAP), fileSize)
+	));
+
+	m_notebook = new wxNotebook(this, wxID_ANY);
+
+	m_typeList = new wxListCtrl(m_notebook, ID_TYPE_LIST, wxDefaultPosition, wxDefaultSize, wxLC_REPORT | wxLC_SINGLE_SEL);
+	m_typeList->AppendColumn("Type", wxLIST_FORMAT_LEFT, 80);
+	m_typeList->AppendColumn("Count", wxLIST_FORMAT_RIGHT, 80);
+	m_typeList->AppendColumn("Total Bytes", wxLIST_FORMAT_RIGHT, 180);
+	m_typeList->AppendColumn("Self Bytes", wxLIST_FORMAT_RIGHT, 180);
+	m_notebook->AddPage(m_typeList, "Chunk Types");
+
+	m_assetList = new wxListCtrl(m_notebook, ID_ASSET_LIST, wxDefaultPosition, wxDefaultSize, wxLC_REPORT | wxLC_SINGLE_SEL);
+	m_assetList->AppendColumn("Type", wxLIST_FORMAT_LEFT, 80);
+	m_assetList->AppendColumn("Name", wxLIST_FORMAT_LEFT, 220);
+	m_assetList->AppendColumn("Position", wxLIST_FORMAT_RIGHT, 100);
+	m_assetList->AppendColumn("Total Bytes", wxLIST_FORMAT_RIGHT, 180);
+	m_assetList->AppendColumn("Chunks", wxLIST_FORMAT_RIGHT, 80);
+	m_notebook->AddPage(m_assetList, "Top Level Assets");
+
+	m_layoutList = new wxLayoutListCtrl(m_notebook, m_tree, m_stats.GetLayout());
+	m_notebook->AddPage(m_layoutList, "File Layout");
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->Add(summary, wxSizerFlags().Border(wxALL, 10));
+	sizer->Add(m_notebook, wxSizerFlags().Expand().Proportion(1).Border(wxLEFT | wxRIGHT, 10));
+
+	wxBoxSizer* buttons = new wxBoxSizer(wxHORIZONTAL);
+	buttons->Add(new wxButton(this, ID_EXPORT_CSV, "Export CSV..."), wxSizerFlags().Border(wxRIGHT, 10));
+	buttons->Add(new wxButton(this, wxID_OK, "Close"));
+	sizer->Add(buttons, wxSizerFlags().Right().Border(wxALL, 10));
+	SetSizer(sizer);
+
+	FillTypeList();
+	FillAssetList();
+}
+
+void StatisticsDialog::FillTypeList()
+{
+	const uint64_t fileSize = m_stats.GetFileSize();
+
+	m_typeList->Freeze();
+	m_typeList->DeleteAllItems();
+	for (size_t i = 0; i < m_types.size(); ++i)
+	{
+		const TypeStatistics& type = m_types[i];
+		long item = m_typeList->InsertItem((long)i, type.m_type);
+		m_typeList->SetItem(item, 1, wxString::Format("%i", (int)type.m_count));
+		m_typeList->SetItem(item, 2, FormatBytes(type.m_totalBytes, fileSize));
+		m_typeList->SetItem(item, 3, FormatBytes(type.m_selfBytes, fileSize));
+	}
+	m_typeList->Thaw();
+}
+
+void StatisticsDialog::FillAssetList()
+{
+	const uint64_t fileSize = m_stats.GetFileSize();
+
+	m_assetList->Freeze();
+	m_assetList->DeleteAllItems();
+	for (size_t i = 0; i < m_assets.size(); ++i)
+	{
+		const AssetStatistics& asset = m_assets[i];
+		long item = m_assetList->InsertItem((long)i, asset.m_type);
+		m_assetList->SetItem(item, 1, asset.m_name);
+		m_assetList->SetItem(item, 2, wxString::Format("%llu", (unsigned long long)asset.m_position));
+		m_assetList->SetItem(item, 3, FormatBytes(asset.m_totalBytes, fileSize));
+		m_assetList->SetItem(item, 4, wxString::Format("%i", (int)asset.m_numChunks));
+	}
+	m_assetList->Thaw();
+}
+
+void StatisticsDialog::OnTypeColumnClick(wxListEvent& event)
+{
+	// names ascending, numbers descending
+	switch (event.GetColumn())
+	{
+		case 0:
+			std::sort(m_types.begin(), m_types.end(), [](const TypeStatistics& a, const TypeStatistics& b) { return a.m_type < b.m_type; });
+			break;
+		case 1:
+			std::sort(m_types.begin(), m_types.end(), [](const TypeStatistics& a, const TypeStatistics& b) { return a.m_count > b.m_count; });
+			break;
+		case 2:
+			std::sort(m_types.begin(), m_types.end(), [](const TypeStatistics& a, const TypeStatistics& b) { return a.m_totalBytes > b.m_totalBytes; });
+			break;
+		case 3:
+			std::sort(m_types.begin(), m_types.end(), [](const TypeStatistics& a, const TypeStatistics& b) { return a.m_selfBytes > b.m_selfBytes; });
+			break;
+		default:
+			return;
+	}
+	FillTypeList();
+}
+
+void StatisticsDialog::OnAssetColumnClick(wxListEvent& event)
+{
+	// names ascending, numbers descending
+	switch (event.GetColumn())
+	{
+		case 0:
+			std::sort(m_assets.begin(), m_assets.end(), [](const AssetStatistics& a, const AssetStatistics& b) { return a.m_type < b.m_type; });
+			break;
+		case 1:
+			std::sort(m_assets.begin(), m_assets.end(), [](const AssetStatistics& a, const AssetStatistics& b) { return a.m_name < b.m_name; });
+			break;
+		case 2:
+			std::sort(m_assets.begin(), m_assets.end(), [](const AssetStatistics& a, const AssetStatistics& b) { return a.m_position < b.m_position; });
+			break;
+		case 3:
+			std::sort(m_assets.begin(), m_assets.end(), [](const AssetStatistics& a, const AssetStatistics& b) { return a.m_totalBytes > b.m_totalBytes; });
+			break;
+		case 4:
+			std::sort(m_assets.begin(), m_assets.end(), [](const AssetStatistics& a, const AssetStatistics& b) { return a.m_numChunks > b.m_numChunks; });
+			break;
+		default:
+			return;
+	}
+	FillAssetList();
+}
+
+void StatisticsDialog::OnExportCSV(wxCommandEvent& event)
+{
+	wxDirDialog dialog(this, "Export types.csv, assets.csv and layout.csv to", "", wxDD_DEFAULT_STYLE);
+	if (dialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	std::string error;
+	if (!m_stats.ExportCSV(dialog.GetPath().ToStdString(), m_tree, error))
+	{
+		wxMessageBox(error, "Error", wxICON_ERROR);
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <wx/wx.h>
+#include <wx/dialog.h>
+#include <wx/listctrl.h>
+#include <wx/notebook.h>
+#include "Core/ChunkStatistics.h"
+
+using std::vector;
+using LVLExplorerCore::ChunkTree;
+using LVLExplorerCore::ChunkStatistics;
+using LVLExplorerCore::TypeStatistics;
+using LVLExplorerCore::AssetStatistics;
+using LVLExplorerCore::LayoutRegion;
+using LVLExplorerCore::ELayoutRegion;
+
+
+/*
+ * Virtual list, since a file layout easily has hundreds of thousands of regions.
+ * Gaps and padding are highlighted.
+ */
+class wxLayoutListCtrl : public wxListCtrl
+{
+public:
+	wxLayoutListCtrl(wxWindow* parent, const ChunkTree& tree, const vector<LayoutRegion>& layout);
+
+private:
+	const ChunkTree& m_tree;
+	const vector<LayoutRegion>& m_layout;
+	wxListItemAttr m_paddingAttr;
+	wxListItemAttr m_gapAttr;
+
+	wxString OnGetItemText(long item, long column) const override;
+	wxListItemAttr* OnGetItemAttr(long item) const override;
+};
+
+class StatisticsDialog : public wxDialog
+{
+public:
+	StatisticsDialog(wxWindow* parent, const ChunkTree& tree, const wxString& sourcePath);
+
+private:
+	const ChunkTree& m_tree;
+	ChunkStatistics m_stats;
+	vector<TypeStatistics> m_types;
+	vector<AssetStatistics> m_assets;
+
+	wxNotebook* m_notebook;
+	wxListCtrl* m_typeList;
+	wxListCtrl* m_assetList;
+	wxLayoutListCtrl* m_layoutList;
+
+private:
+	void FillTypeList();
+	void FillAssetList();
+
+	// events
+	void OnTypeColumnClick(wxListEvent& event);
+	void OnAssetColumnClick(wxListEvent& event);
+	void OnExportCSV(wxCommandEvent& event);
+
+	wxDECLARE_EVENT_TABLE();
+};
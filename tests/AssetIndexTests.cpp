@@ -0,0 +1,251 @@
+#include "TestFramework.h"
+#include "TestFiles.h"
+#include "Core/AssetIndex.h"
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+using namespace LVLExplorerTests;
+using LVLExplorerCore::AssetIndex;
+using LVLExplorerCore::AssetIndexEntry;
+
+
+static uint64_t WriteAsset(ChunkWriter& writer, const char (&type)[5], const char (&nameChunk)[5], const std::string& name)
+{
+	uint64_t position = writer.Begin(type);
+	writer.Leaf("INFO", "abc");
+	writer.Leaf(nameChunk, name + '\0');
+	writer.End();
+	return position;
+}
+
+struct TestLevels
+{
+	TempDirectory m_directory;
+	uint64_t m_texture;
+	uint64_t m_entityClass;
+	uint64_t m_model;
+
+	TestLevels()
+	{
+		fs::create_directories(m_directory.GetFilePath("sub"));
+
+		ChunkWriter first;
+		first.Begin("ucfb");
+		m_texture = WriteAsset(first, "tex_", "NAME", "rock");
+		m_entityClass = WriteAsset(first, "entc", "TYPE", "com_bldg");
+		first.BeginLevel(0x12345678);
+		m_model = WriteAsset(first, "modl", "NAME", "Rock");
+		first.End();
+		first.End();
+		first.Save(m_directory.GetFilePath("first.lvl"));
+
+		WriteSecond(false);
+
+		// not a level file, must be ignored
+		std::ofstream(m_directory.GetFilePath("readme.txt")) << "rock";
+	}
+
+	void WriteSecond(bool bWithTree)
+	{
+		ChunkWriter second;
+		second.Begin("ucfb");
+		WriteAsset(second, "skel", "NAME", "soldier");
+		if (bWithTree)
+		{
+			WriteAsset(second, "modl", "NAME", "tree");
+		}
+		second.End();
+		second.Save((fs::path(m_directory.GetPath()) / "sub" / "second.lvl").string());
+	}
+};
+
+TEST(AssetIndex, ScanAndFind)
+{
+	TestLevels levels;
+
+	AssetIndex index;
+	std::string error;
+	REQUIRE(index.StartScan(levels.m_directory.GetPath(), error, 2));
+	index.WaitUntilDone();
+	CHECK(index.IsDone());
+	CHECK(index.GetScanError().empty());
+	CHECK(index.GetFiles().size() == 2);
+	CHECK(index.GetNumParsedFiles() == 2);
+
+	// case insensitive, across sub levels
+	std::vector<AssetIndexEntry> entries = index.Find("ROCK");
+	CHECK(entries.size() == 2);
+
+	entries = index.Find("rock", "modl");
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0].m_asset->m_name == "Rock");
+	CHECK(entries[0].m_asset->m_position == levels.m_model);
+	CHECK(fs::path(entries[0].m_file->m_path).filename() == "first.lvl");
+
+	entries = index.Find("com_bldg");
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0].m_asset->m_type == "entc");
+	CHECK(entries[0].m_asset->m_position == levels.m_entityClass);
+
+	entries = index.Find("soldier", "tex_");
+	CHECK(entries.empty());
+	entries = index.Find("soldier");
+	REQUIRE(entries.size() == 1);
+	CHECK(fs::path(entries[0].m_file->m_path).filename() == "second.lvl");
+}
+
+TEST(AssetIndex, SaveLoadRoundTrip)
+{
+	TestLevels levels;
+
+	AssetIndex index;
+	std::string error;
+	REQUIRE(index.StartScan(levels.m_directory.GetPath(), error));
+	index.WaitUntilDone();
+
+	std::string indexPath = levels.m_directory.GetFilePath("index.txt");
+	REQUIRE(index.Save(indexPath));
+
+	AssetIndex loaded;
+	REQUIRE(loaded.Load(indexPath));
+	CHECK(loaded.GetDirectory() == index.GetDirectory());
+	REQUIRE(loaded.GetFiles().size() == index.GetFiles().size());
+	for (size_t i = 0; i < index.GetFiles().size(); ++i)
+	{
+		const LVLExplorerCore::IndexedFile& expected = index.GetFiles()[i];
+		const LVLExplorerCore::IndexedFile& actual = loaded.GetFiles()[i];
+		CHECK(actual.m_path == expected.m_path);
+		CHECK(actual.m_fileSize == expected.m_fileSize);
+		CHECK(actual.m_modifiedTime == expected.m_modifiedTime);
+		REQUIRE(actual.m_assets.size() == expected.m_assets.size());
+		for (size_t a = 0; a < expected.m_assets.size(); ++a)
+		{
+			CHECK(actual.m_assets[a].m_type == expected.m_assets[a].m_type);
+			CHECK(actual.m_assets[a].m_name == expected.m_assets[a].m_name);
+			CHECK(actual.m_assets[a].m_position == expected.m_assets[a].m_position);
+			CHECK(actual.m_assets[a].m_size == expected.m_assets[a].m_size);
+		}
+	}
+	CHECK(loaded.Find("rock", "tex_").size() == 1);
+}
+
+TEST(AssetIndex, IncrementalRescan)
+{
+	TestLevels levels;
+	std::string indexPath = levels.m_directory.GetFilePath("index.txt");
+
+	{
+		AssetIndex index;
+		std::string error;
+		REQUIRE(index.StartScan(levels.m_directory.GetPath(), error));
+		index.WaitUntilDone();
+		REQUIRE(index.Save(indexPath));
+	}
+
+	// changes the file size, so it has to be parsed again
+	levels.WriteSecond(true);
+
+	AssetIndex index;
+	REQUIRE(index.Load(indexPath));
+
+	std::string error;
+	REQUIRE(index.StartScan(levels.m_directory.GetPath(), error));
+	index.WaitUntilDone();
+	CHECK(index.GetScanError().empty());
+	CHECK(index.GetFiles().size() == 2);
+	CHECK(index.GetNumParsedFiles() == 1);
+
+	// reused and parsed files are both found
+	CHECK(index.Find("tree").size() == 1);
+	CHECK(index.Find("rock").size() == 2);
+}
+
+TEST(AssetIndex, CancelKeepsIndex)
+{
+	TestLevels levels;
+
+	AssetIndex index;
+	std::string error;
+	REQUIRE(index.StartScan(levels.m_directory.GetPath(), error));
+	index.WaitUntilDone();
+	REQUIRE(index.GetFiles().size() == 2);
+
+	// enough files that the scan cannot finish before it gets cancelled
+	for (int i = 0; i < 500; ++i)
+	{
+		fs::copy_file(levels.m_directory.GetFilePath("first.lvl"), levels.m_directory.GetFilePath("copy" + std::to_string(i) + ".lvl"));
+	}
+	levels.WriteSecond(true);
+
+	REQUIRE(index.StartScan(levels.m_directory.GetPath(), error, 1));
+	index.CancelScan();
+	index.WaitUntilDone();
+	CHECK(!index.GetScanError().empty());
+
+	// neither the new files nor the lost reused assets show up
+	CHECK(index.GetFiles().size() == 2);
+	CHECK(index.Find("rock").size() == 2);
+	CHECK(index.Find("soldier").size() == 1);
+	CHECK(index.Find("tree").empty());
+}
+
+TEST(AssetIndex, SkipUninspectableFiles)
+{
+	TestLevels levels;
+
+	// a broken link cannot be inspected, creating links may need extra rights on Windows
+	std::error_code linkError;
+	fs::create_symlink(levels.m_directory.GetFilePath("missing.lvl"), levels.m_directory.GetFilePath("broken.lvl"), linkError);
+	if (linkError)
+		return;
+
+	AssetIndex index;
+	std::string error;
+	REQUIRE(index.StartScan(levels.m_directory.GetPath(), error));
+	index.WaitUntilDone();
+	CHECK(index.GetScanError().empty());
+	REQUIRE(index.GetFiles().size() == 2);
+	for (const LVLExplorerCore::IndexedFile& file : index.GetFiles())
+	{
+		CHECK(fs::path(file.m_path).filename() != "broken.lvl");
+		CHECK(file.m_fileSize == fs::file_size(file.m_path));
+	}
+}
+
+TEST(AssetIndex, RejectMissingDirectory)
+{
+	TempDirectory directory;
+
+	AssetIndex index;
+	std::string error;
+	CHECK(!index.StartScan(directory.GetFilePath("missing"), error));
+	CHECK(!error.empty());
+	CHECK(index.IsDone());
+}
+
+TEST(AssetIndex, RejectMalformedIndex)
+{
+	TempDirectory directory;
+	std::string indexPath = directory.GetFilePath("index.txt");
+
+	std::ofstream(indexPath) << "LVLExplorerIndex 1\nD /data\nF 100 5 /data/a.lvl\nA tex_ 16 48 rock\n";
+	AssetIndex index;
+	CHECK(index.Load(indexPath));
+	CHECK(index.Find("rock").size() == 1);
+
+	const char* malformed[] = {
+		"LVLExplorerIndex 1\nD /data\nF abc 5 /data/a.lvl\n",
+		"LVLExplorerIndex 1\nD /data\nF 100 5\n",
+		"LVLExplorerIndex 1\nD /data\nF 100 5 /data/a.lvl\nA tex_ x 48 rock\n",
+		"LVLExplorerIndex 1\nD /data\nF 100 5 /data/a.lvl\nA tex_ 16 48\n",
+		"LVLExplorerIndex 1\nD /data\nA tex_ 16 48 rock\n",
+		"LVLExplorerIndex 2\nD /data\n"
+	};
+	for (const char* content : malformed)
+	{
+		std::ofstream(indexPath, std::ios::trunc) << content;
+		CHECK(!index.Load(indexPath));
+		CHECK(index.GetFiles().empty());
+	}
+}
@@ -0,0 +1,171 @@
+#include "TestFramework.h"
+#include "TestFiles.h"
+#include "Core/ChunkExtractor.h"
+#include "Core/RawChunkFile.h"
+#include <algorithm>
+
+using namespace LVLExplorerTests;
+using LVLExplorerCore::ChunkExtractor;
+using LVLExplorerCore::ChunkRange;
+using LVLExplorerCore::RawChunk;
+using LVLExplorerCore::RawChunkFile;
+
+
+static bool IsSlice(const std::vector<uint8_t>& data, const std::vector<uint8_t>& source, uint64_t position, uint64_t size, uint64_t offset = 0)
+{
+	return offset + size <= data.size() && position + size <= source.size()
+		&& std::equal(source.begin() + position, source.begin() + position + size, data.begin() + offset);
+}
+
+TEST(ChunkExtractor, ExtractChunk)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t first = writer.Leaf("abcd", "hello");
+	uint64_t second = writer.Begin("efgh");
+	writer.Leaf("NAME", "rock");
+	writer.End();
+	writer.End();
+
+	TempDirectory directory;
+	std::string sourcePath = directory.GetFilePath("source.lvl");
+	REQUIRE(writer.Save(sourcePath));
+
+	ChunkExtractor extractor;
+	std::string error;
+	REQUIRE(extractor.Open(sourcePath, error));
+	CHECK(extractor.GetSourceSize() == writer.GetData().size());
+
+	std::string targetPath = directory.GetFilePath("first.chunk");
+	REQUIRE(extractor.ExtractChunk({ first, 8 + 5 }, targetPath, error));
+
+	std::vector<uint8_t> extracted;
+	REQUIRE(ReadWholeFile(targetPath, extracted));
+	CHECK(extracted.size() == 8 + 5);
+	CHECK(IsSlice(extracted, writer.GetData(), first, 8 + 5));
+
+	targetPath = directory.GetFilePath("second.chunk");
+	REQUIRE(extractor.ExtractChunk({ second, 8 + 12 }, targetPath, error));
+	REQUIRE(ReadWholeFile(targetPath, extracted));
+	CHECK(extracted.size() == 8 + 12);
+	CHECK(IsSlice(extracted, writer.GetData(), second, 8 + 12));
+
+	// beyond the end of the source
+	error.clear();
+	CHECK(!extractor.ExtractChunk({ second, 1024 }, directory.GetFilePath("invalid.chunk"), error));
+	CHECK(!error.empty());
+}
+
+TEST(ChunkExtractor, ExtractContainer)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t first = writer.Leaf("abcd", "hello");
+	uint64_t second = writer.Leaf("efgh", "1234");
+	writer.End();
+
+	TempDirectory directory;
+	std::string sourcePath = directory.GetFilePath("source.lvl");
+	REQUIRE(writer.Save(sourcePath));
+
+	ChunkExtractor extractor;
+	std::string error;
+	REQUIRE(extractor.Open(sourcePath, error));
+
+	std::string targetPath = directory.GetFilePath("container.lvl");
+	REQUIRE(extractor.ExtractContainer({ { first, 8 + 5 }, { second, 8 + 4 } }, targetPath, error));
+
+	// the first chunk gets padded to keep the second one aligned
+	std::vector<uint8_t> extracted;
+	REQUIRE(ReadWholeFile(targetPath, extracted));
+	CHECK(extracted.size() == 8 + 16 + 12);
+	CHECK(IsSlice(extracted, writer.GetData(), first, 8 + 5, 8));
+	CHECK(IsSlice(extracted, writer.GetData(), second, 8 + 4, 8 + 16));
+
+	RawChunkFile file;
+	REQUIRE(file.Open(targetPath));
+
+	RawChunk root;
+	REQUIRE(file.ReadChunk(0, root));
+	CHECK(root.GetHeaderName() == "ucfb");
+	CHECK(root.GetEnd() == extracted.size());
+
+	std::vector<RawChunk> children;
+	REQUIRE(file.ReadChildren(root, children));
+	REQUIRE(children.size() == 2);
+	CHECK(children[0].GetHeaderName() == "abcd" && children[0].m_dataSize == 5);
+	CHECK(children[1].GetHeaderName() == "efgh" && children[1].m_dataSize == 4);
+}
+
+TEST(ChunkExtractor, RejectSourceAsTarget)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t first = writer.Leaf("abcd", "hello");
+	writer.End();
+
+	TempDirectory directory;
+	std::string sourcePath = directory.GetFilePath("source.lvl");
+	REQUIRE(writer.Save(sourcePath));
+
+	ChunkExtractor extractor;
+	std::string error;
+	REQUIRE(extractor.Open(sourcePath, error));
+
+	// also when spelled differently
+	CHECK(!extractor.ExtractChunk({ first, 8 + 5 }, sourcePath, error));
+	CHECK(!error.empty());
+	error.clear();
+	CHECK(!extractor.ExtractContainer({ { first, 8 + 5 } }, directory.GetFilePath(".") + "/source.lvl", error));
+	CHECK(!error.empty());
+
+	std::vector<uint8_t> data;
+	REQUIRE(ReadWholeFile(sourcePath, data));
+	CHECK(data == writer.GetData());
+}
+
+TEST(ChunkExtractor, ReportShortRead)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t first = writer.Leaf("abcd", "hello");
+	writer.End();
+
+	TempDirectory directory;
+	std::string sourcePath = directory.GetFilePath("source.lvl");
+	REQUIRE(writer.Save(sourcePath));
+
+	ChunkExtractor extractor;
+	std::string error;
+	REQUIRE(extractor.Open(sourcePath, error));
+
+	// shrinks behind the extractors back
+	REQUIRE(ChunkWriter().Save(sourcePath));
+
+	CHECK(!extractor.ExtractChunk({ first, 8 + 5 }, directory.GetFilePath("first.chunk"), error));
+	CHECK(error.find("end of source file") != std::string::npos);
+}
+
+TEST(ChunkExtractor, RemoveNestedRanges)
+{
+	std::vector<ChunkRange> chunks = {
+		{ 100, 10 },
+		{ 0, 200 },
+		{ 50, 20 },
+		{ 300, 8 },
+		{ 300, 16 },
+		{ 316, 8 }
+	};
+	ChunkExtractor::RemoveNestedRanges(chunks);
+
+	REQUIRE(chunks.size() == 3);
+	CHECK(chunks[0].m_position == 0 && chunks[0].m_size == 200);
+	CHECK(chunks[1].m_position == 300 && chunks[1].m_size == 16);
+	CHECK(chunks[2].m_position == 316 && chunks[2].m_size == 8);
+}
+
+TEST(ChunkExtractor, MakeChunkFileName)
+{
+	CHECK(ChunkExtractor::MakeChunkFileName("tex_", 1234) == "tex__1234.chunk");
+	CHECK(ChunkExtractor::MakeChunkFileName("a/b:", 0) == "a_b__0.chunk");
+}
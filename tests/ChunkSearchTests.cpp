@@ -0,0 +1,94 @@
+#include "TestFramework.h"
+#include "TestFiles.h"
+#include "Core/ChunkSearch.h"
+#include "Core/Document.h"
+
+using namespace LVLExplorerTests;
+using LVLExplorerCore::ChunkTree;
+using LVLExplorerCore::Document;
+using LVLExplorerCore::SearchChunkTree;
+using LVLExplorerCore::SearchMatch;
+
+
+TEST(ChunkSearch, PropagateToParents)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t sibling = writer.Leaf("abcd", "abc");
+	uint64_t level = writer.BeginLevel(0x12345678);
+	uint64_t match = writer.Leaf("qzqz", "abc");
+	uint64_t cousin = writer.Leaf("abcd", "abc");
+	writer.End();
+	writer.End();
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	Document document;
+	std::string error;
+	REQUIRE(document.Open(path, error));
+	REQUIRE(document.WaitUntilLoaded(error));
+
+	const ChunkTree& tree = document.GetTree();
+	size_t rootNode = tree.GetRoot();
+	size_t siblingNode = tree.FindNode(sibling, "abcd");
+	size_t levelNode = tree.FindNode(level, "lvl_");
+	size_t matchNode = tree.FindNode(match, "qzqz");
+	size_t cousinNode = tree.FindNode(cousin, "abcd");
+	REQUIRE(rootNode != ChunkTree::NONE);
+	REQUIRE(siblingNode != ChunkTree::NONE);
+	REQUIRE(levelNode != ChunkTree::NONE);
+	REQUIRE(matchNode != ChunkTree::NONE);
+	REQUIRE(cousinNode != ChunkTree::NONE);
+
+	std::vector<SearchMatch> matches;
+	SearchChunkTree(tree, "qzqz", matches);
+	REQUIRE(matches.size() == tree.GetNodeCount());
+
+	CHECK(matches[matchNode].m_foundInName);
+	CHECK(matches[matchNode].IsFound());
+	CHECK(!matches[matchNode].m_foundInChildren);
+
+	// every ancestor knows, siblings do not
+	CHECK(matches[levelNode].m_foundInChildren);
+	CHECK(matches[rootNode].m_foundInChildren);
+	CHECK(!matches[siblingNode].m_foundInName && !matches[siblingNode].m_foundInChildren);
+	CHECK(!matches[cousinNode].m_foundInName && !matches[cousinNode].m_foundInChildren);
+
+	// display names include the child index
+	SearchChunkTree(tree, "[1] lvl_", matches);
+	CHECK(matches[levelNode].m_foundInName);
+	CHECK(matches[rootNode].m_foundInChildren);
+}
+
+TEST(ChunkSearch, EmptySearchMatchesNothing)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	writer.BeginLevel(0x12345678);
+	writer.Leaf("abcd", "abc");
+	writer.End();
+	writer.End();
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	Document document;
+	std::string error;
+	REQUIRE(document.Open(path, error));
+	REQUIRE(document.WaitUntilLoaded(error));
+
+	std::vector<SearchMatch> matches;
+	SearchChunkTree(document.GetTree(), "abcd", matches);
+
+	// resets all previous results
+	SearchChunkTree(document.GetTree(), "", matches);
+	REQUIRE(matches.size() == document.GetTree().GetNodeCount());
+	for (const SearchMatch& match : matches)
+	{
+		CHECK(!match.IsFound());
+		CHECK(!match.m_foundInChildren);
+	}
+}
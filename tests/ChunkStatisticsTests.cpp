@@ -0,0 +1,103 @@
+#include "TestFramework.h"
+#include "TestFiles.h"
+#include "Core/ChunkStatistics.h"
+#include "Core/Document.h"
+
+using namespace LVLExplorerTests;
+using LVLExplorerCore::AssetStatistics;
+using LVLExplorerCore::ChunkStatistics;
+using LVLExplorerCore::ChunkTree;
+using LVLExplorerCore::Document;
+using LVLExplorerCore::ELayoutRegion;
+using LVLExplorerCore::LayoutRegion;
+
+
+static const LayoutRegion* FindRegion(const ChunkStatistics& statistics, uint64_t start)
+{
+	for (const LayoutRegion& region : statistics.GetLayout())
+	{
+		if (region.m_start == start)
+			return &region;
+	}
+	return nullptr;
+}
+
+TEST(ChunkStatistics, LayoutAndPadding)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t unaligned = writer.Leaf("abcd", "hello");
+	uint64_t level = writer.BeginLevel(0x12345678);
+	uint64_t asset = writer.Begin("zzzz");
+	writer.Leaf("NAME", std::string("rock\0", 5));
+	writer.End();
+	writer.End();
+	writer.End();
+	uint64_t rootEnd = writer.GetPosition();
+
+	// not covered by any chunk
+	writer.Write("0123456789ABCDEF", 16);
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	Document document;
+	std::string error;
+	REQUIRE(document.Open(path, error));
+	REQUIRE(document.WaitUntilLoaded(error));
+	const ChunkTree& tree = document.GetTree();
+
+	ChunkStatistics statistics;
+	statistics.Compute(tree, path, 2);
+	CHECK(statistics.GetFileSize() == writer.GetData().size());
+
+	// sorted, without overlaps or holes, covering the whole file
+	uint64_t position = 0;
+	uint64_t totalBytes = 0;
+	for (const LayoutRegion& region : statistics.GetLayout())
+	{
+		CHECK(region.m_start == position);
+		CHECK(region.m_size > 0);
+		position = region.m_start + region.m_size;
+	}
+	CHECK(position == writer.GetData().size());
+	for (ELayoutRegion kind : { ELayoutRegion::HEADER, ELayoutRegion::DATA, ELayoutRegion::PADDING, ELayoutRegion::GAP })
+	{
+		totalBytes += statistics.GetBytes(kind);
+	}
+	CHECK(totalBytes == writer.GetData().size());
+	CHECK(statistics.GetBytes(ELayoutRegion::HEADER) == tree.GetNodeCount() * 8);
+
+	// 5 data bytes are followed by 3 bytes of padding
+	const LayoutRegion* region = FindRegion(statistics, unaligned + 8 + 5);
+	REQUIRE(region != nullptr);
+	CHECK(region->m_kind == ELayoutRegion::PADDING);
+	CHECK(region->m_size == 3);
+	CHECK(region->m_nodeIndex == tree.GetRoot());
+
+	// name hash and size of the sub level belong to its own data
+	region = FindRegion(statistics, level + 8);
+	REQUIRE(region != nullptr);
+	CHECK(region->m_kind == ELayoutRegion::DATA);
+	CHECK(region->m_size == 8);
+	CHECK(region->m_nodeIndex == tree.FindNode(level, "lvl_"));
+
+	region = FindRegion(statistics, rootEnd);
+	REQUIRE(region != nullptr);
+	CHECK(region->m_kind == ELayoutRegion::GAP);
+	CHECK(region->m_size == 16);
+
+	// sub level contents are top level assets as well
+	bool bFoundAsset = false;
+	for (const AssetStatistics& stats : statistics.GetAssets())
+	{
+		if (stats.m_position == asset)
+		{
+			bFoundAsset = true;
+			CHECK(stats.m_type == "zzzz");
+			CHECK(stats.m_name == "rock");
+		}
+	}
+	CHECK(bFoundAsset);
+}
@@ -0,0 +1,152 @@
+#include "TestFramework.h"
+#include "TestFiles.h"
+#include "Core/ProgressiveLoader.h"
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace LVLExplorerTests;
+using LVLExplorerCore::ProgressiveLoader;
+using LVLExplorerCore::RawSubtree;
+
+
+struct TestLevel
+{
+	TempDirectory m_directory;
+	std::string m_path;
+	uint64_t m_asset;
+	uint64_t m_name;
+	uint64_t m_leaf;
+
+	TestLevel()
+	{
+		ChunkWriter writer;
+		writer.Begin("ucfb");
+		writer.Leaf("abcd", "abc");
+		writer.BeginLevel(0x12345678);
+		m_asset = writer.Begin("modl");
+		m_name = writer.Leaf("NAME", "abc");
+		writer.End();
+		m_leaf = writer.Leaf("efgh", "abc");
+		writer.End();
+		writer.Leaf("ijkl", "abc");
+		writer.Begin("mnop");
+		writer.Leaf("qrst", "abc");
+		writer.End();
+		writer.Leaf("uvwx", "abc");
+		writer.End();
+
+		m_path = m_directory.GetFilePath("test.lvl");
+		writer.Save(m_path);
+	}
+};
+
+static bool WaitUntilDone(const ProgressiveLoader& loader)
+{
+	for (int i = 0; i < 500 && !loader.IsDone(); ++i)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	return loader.IsDone();
+}
+
+TEST(ProgressiveLoader, TopLevelChunks)
+{
+	TestLevel level;
+
+	ProgressiveLoader loader;
+	std::string error;
+	REQUIRE(loader.Open(level.m_path, error));
+	CHECK(loader.IsOpen());
+	CHECK(loader.GetRoot().GetHeaderName() == "ucfb");
+
+	// available right away, before anything has been parsed
+	const std::vector<LVLExplorerCore::RawChunk>& topLevel = loader.GetTopLevelChunks();
+	REQUIRE(topLevel.size() == 5);
+	CHECK(topLevel[0].GetHeaderName() == "abcd");
+	CHECK(topLevel[1].GetHeaderName() == "lvl_");
+	CHECK(topLevel[4].GetHeaderName() == "uvwx");
+	CHECK(!loader.IsDone());
+	CHECK(loader.GetProgress() == 0.0f);
+
+	ChunkWriter writer;
+	writer.Leaf("abcd", "abc");
+	std::string path = level.m_directory.GetFilePath("noucfb.lvl");
+	REQUIRE(writer.Save(path));
+	CHECK(!loader.Open(path, error));
+	CHECK(!loader.IsOpen());
+}
+
+TEST(ProgressiveLoader, PrioritizedOrder)
+{
+	TestLevel level;
+
+	ProgressiveLoader loader;
+	std::string error;
+	REQUIRE(loader.Open(level.m_path, error));
+
+	// hold the worker after its first subtree, until the priority has been changed
+	std::promise<void> firstParsed;
+	std::future<void> parsed = firstParsed.get_future();
+	std::promise<void> resume;
+	std::shared_future<void> resumed = resume.get_future().share();
+	bool bFirst = true;
+	loader.Start([&]()
+	{
+		if (bFirst)
+		{
+			bFirst = false;
+			firstParsed.set_value();
+			resumed.wait();
+		}
+	});
+
+	REQUIRE(parsed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+	loader.Prioritize(3);
+	resume.set_value();
+	REQUIRE(WaitUntilDone(loader));
+	CHECK(loader.GetProgress() == 1.0f);
+
+	std::vector<size_t> order;
+	size_t topLevelIndex;
+	while (loader.TakeParsedSubtree(topLevelIndex))
+	{
+		order.push_back(topLevelIndex);
+	}
+	CHECK(order == std::vector<size_t>({ 0, 3, 1, 2, 4 }));
+}
+
+TEST(ProgressiveLoader, SubtreePreOrder)
+{
+	TestLevel level;
+
+	ProgressiveLoader loader;
+	std::string error;
+	REQUIRE(loader.Open(level.m_path, error));
+	loader.Start(nullptr);
+	REQUIRE(WaitUntilDone(loader));
+
+	// lvl_ { modl { NAME }, efgh }
+	const RawSubtree& subtree = loader.GetSubtree(1);
+	REQUIRE(subtree.m_nodes.size() == 4);
+	CHECK(subtree.m_nodes[0].m_chunk.GetHeaderName() == "lvl_");
+	CHECK(subtree.m_nodes[0].m_parent == ProgressiveLoader::NONE);
+	CHECK(subtree.m_nodes[0].m_childIndex == 1);
+	CHECK(subtree.m_nodes[0].m_children == std::vector<size_t>({ 1, 3 }));
+
+	CHECK(subtree.m_nodes[1].m_chunk.m_position == level.m_asset);
+	CHECK(subtree.m_nodes[1].m_parent == 0);
+	CHECK(subtree.m_nodes[1].m_childIndex == 0);
+	CHECK(subtree.m_nodes[1].m_children == std::vector<size_t>({ 2 }));
+
+	CHECK(subtree.m_nodes[2].m_chunk.m_position == level.m_name);
+	CHECK(subtree.m_nodes[2].m_parent == 1);
+	CHECK(subtree.m_nodes[2].m_children.empty());
+
+	CHECK(subtree.m_nodes[3].m_chunk.m_position == level.m_leaf);
+	CHECK(subtree.m_nodes[3].m_parent == 0);
+	CHECK(subtree.m_nodes[3].m_childIndex == 1);
+
+	// leaf top level chunks only consist of themselves
+	CHECK(loader.GetSubtree(0).m_nodes.size() == 1);
+}
@@ -0,0 +1,208 @@
+#include "TestFramework.h"
+#include "TestFiles.h"
+#include "Core/RawChunkFile.h"
+
+using namespace LVLExplorerTests;
+using LVLExplorerCore::MakeMagic;
+using LVLExplorerCore::RawChunk;
+using LVLExplorerCore::RawChunkFile;
+
+
+TEST(RawChunkFile, ReadChunk)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t leaf = writer.Leaf("abcd", "hello");
+	writer.End();
+
+	// claims more data than the file has
+	uint64_t truncated = writer.GetPosition();
+	writer.Write("zzzz", 4);
+	writer.WriteUInt32(0x1000);
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	RawChunkFile file;
+	REQUIRE(file.Open(path));
+	CHECK(file.GetFileSize() == writer.GetData().size());
+
+	RawChunk chunk;
+	REQUIRE(file.ReadChunk(0, chunk));
+	CHECK(chunk.m_magic == MakeMagic("ucfb"));
+	CHECK(chunk.GetHeaderName() == "ucfb");
+	CHECK(chunk.GetEnd() == writer.GetData().size() - 8);
+
+	REQUIRE(file.ReadChunk(leaf, chunk));
+	CHECK(chunk.GetHeaderName() == "abcd");
+	CHECK(chunk.m_dataSize == 5);
+	CHECK(chunk.GetDataPosition() == leaf + 8);
+
+	CHECK(!file.ReadChunk(truncated, chunk));
+
+	// no printable magic
+	CHECK(!file.ReadChunk(leaf + 4, chunk));
+
+	// no room for a header
+	CHECK(!file.ReadChunk(writer.GetData().size() - 4, chunk));
+}
+
+TEST(RawChunkFile, ReadChildren)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t first = writer.Leaf("abcd", "hello");
+	uint64_t second = writer.Leaf("efgh", "1234");
+	writer.End();
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	RawChunkFile file;
+	REQUIRE(file.Open(path));
+
+	RawChunk root;
+	REQUIRE(file.ReadChunk(0, root));
+
+	std::vector<RawChunk> children;
+	REQUIRE(file.ReadChildren(root, children));
+	REQUIRE(children.size() == 2);
+	CHECK(children[0].m_position == first);
+	CHECK(children[0].GetHeaderName() == "abcd");
+
+	// behind the padding of the first child
+	CHECK(children[1].m_position == second);
+	CHECK(second == first + 16);
+	CHECK(children[1].GetHeaderName() == "efgh");
+
+	// leaf data is no chunk sequence
+	CHECK(!file.ReadChildren(children[0], children));
+	CHECK(children.empty());
+}
+
+TEST(RawChunkFile, ReadChildrenOfSubLevel)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t level = writer.BeginLevel(0xDEADBEEF);
+	uint64_t first = writer.Leaf("abcd", "x");
+	uint64_t second = writer.Leaf("efgh", "y");
+	writer.End();
+	writer.End();
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	RawChunkFile file;
+	REQUIRE(file.Open(path));
+
+	RawChunk chunk;
+	REQUIRE(file.ReadChunk(level, chunk));
+	CHECK(chunk.GetHeaderName() == "lvl_");
+
+	// children start behind the name hash and size
+	std::vector<RawChunk> children;
+	REQUIRE(file.ReadChildren(chunk, children));
+	REQUIRE(children.size() == 2);
+	CHECK(children[0].m_position == first);
+	CHECK(first == chunk.GetDataPosition() + 8);
+	CHECK(children[1].m_position == second);
+}
+
+TEST(RawChunkFile, RejectTrailingData)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t parent = writer.Begin("abcd");
+	writer.Leaf("efgh", "");
+	writer.Write("\x7F\x7F\x7F\x7F", 4);
+	writer.End();
+	writer.End();
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	RawChunkFile file;
+	REQUIRE(file.Open(path));
+
+	RawChunk chunk;
+	REQUIRE(file.ReadChunk(parent, chunk));
+
+	// a valid chunk followed by 4 bytes that are neither padding nor a chunk header
+	std::vector<RawChunk> children;
+	CHECK(!file.ReadChildren(chunk, children));
+	CHECK(children.empty());
+}
+
+TEST(RawChunkFile, ReadString)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t name = writer.Leaf("NAME", std::string("rock\0junk", 9));
+	uint64_t unterminated = writer.Leaf("NAME", "tree");
+	writer.End();
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	RawChunkFile file;
+	REQUIRE(file.Open(path));
+
+	// up to the first null terminator
+	RawChunk chunk;
+	std::string text;
+	REQUIRE(file.ReadChunk(name, chunk));
+	CHECK(file.ReadString(chunk, text));
+	CHECK(text == "rock");
+
+	REQUIRE(file.ReadChunk(unterminated, chunk));
+	CHECK(file.ReadString(chunk, text));
+	CHECK(text == "tree");
+}
+
+TEST(RawChunkFile, ReadAssetName)
+{
+	ChunkWriter writer;
+	writer.Begin("ucfb");
+	uint64_t texture = writer.Begin("tex_");
+	writer.Leaf("TYPE", std::string("not_this\0", 9));
+	writer.Leaf("NAME", std::string("rock\0", 5));
+	writer.End();
+
+	uint64_t entityClass = writer.Begin("entc");
+	writer.Leaf("TYPE", std::string("com_bldg\0", 9));
+	writer.End();
+
+	uint64_t unnamed = writer.Begin("modl");
+	writer.Leaf("INFO", "abc");
+	writer.End();
+	writer.End();
+
+	TempDirectory directory;
+	std::string path = directory.GetFilePath("test.lvl");
+	REQUIRE(writer.Save(path));
+
+	RawChunkFile file;
+	REQUIRE(file.Open(path));
+
+	RawChunk chunk;
+	std::string text;
+
+	// NAME wins over TYPE, class definitions only have a TYPE
+	REQUIRE(file.ReadChunk(texture, chunk));
+	CHECK(file.ReadAssetName(chunk, text));
+	CHECK(text == "rock");
+
+	REQUIRE(file.ReadChunk(entityClass, chunk));
+	CHECK(file.ReadAssetName(chunk, text));
+	CHECK(text == "com_bldg");
+
+	REQUIRE(file.ReadChunk(unnamed, chunk));
+	CHECK(!file.ReadAssetName(chunk, text));
+	CHECK(text.empty());
+}
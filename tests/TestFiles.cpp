@@ -0,0 +1,135 @@
+#include "TestFiles.h"
+#include "Core/RawChunkFile.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+using LVLExplorerCore::CHUNK_ALIGNMENT;
+using LVLExplorerCore::CHUNK_HEADER_SIZE;
+
+
+namespace LVLExplorerTests
+{
+	uint64_t ChunkWriter::Begin(const char (&magic)[5])
+	{
+		uint64_t position = GetPosition();
+		Write(magic, 4);
+		WriteUInt32(0);
+		m_open.push_back({ position, false });
+		return position;
+	}
+
+	uint64_t ChunkWriter::BeginLevel(uint32_t nameHash)
+	{
+		uint64_t position = Begin("lvl_");
+		m_open.back().m_bLevel = true;
+		WriteUInt32(nameHash);
+		WriteUInt32(0);
+		return position;
+	}
+
+	void ChunkWriter::End()
+	{
+		OpenChunk chunk = m_open.back();
+		m_open.pop_back();
+
+		const uint64_t dataSize = GetPosition() - chunk.m_position - CHUNK_HEADER_SIZE;
+		PatchUInt32(chunk.m_position + 4, (uint32_t)dataSize);
+		if (chunk.m_bLevel)
+		{
+			PatchUInt32(chunk.m_position + CHUNK_HEADER_SIZE + 4, (uint32_t)dataSize - 8);
+		}
+
+		while (GetPosition() % CHUNK_ALIGNMENT != 0)
+		{
+			m_data.push_back(0);
+		}
+	}
+
+	uint64_t ChunkWriter::Leaf(const char (&magic)[5], const std::string& data)
+	{
+		uint64_t position = Begin(magic);
+		Write(data.data(), data.size());
+		End();
+		return position;
+	}
+
+	void ChunkWriter::Write(const void* data, size_t size)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		m_data.insert(m_data.end(), bytes, bytes + size);
+	}
+
+	void ChunkWriter::WriteUInt32(uint32_t value)
+	{
+		// little endian on disk
+		for (int i = 0; i < 4; ++i)
+		{
+			m_data.push_back((uint8_t)(value >> (i * 8)));
+		}
+	}
+
+	uint64_t ChunkWriter::GetPosition() const
+	{
+		return m_data.size();
+	}
+
+	const std::vector<uint8_t>& ChunkWriter::GetData() const
+	{
+		return m_data;
+	}
+
+	bool ChunkWriter::Save(const std::string& path) const
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream.write((const char*)m_data.data(), (std::streamsize)m_data.size());
+		return stream.good();
+	}
+
+	void ChunkWriter::PatchUInt32(uint64_t position, uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			m_data[position + i] = (uint8_t)(value >> (i * 8));
+		}
+	}
+
+	TempDirectory::TempDirectory()
+	{
+		static std::atomic<unsigned int> counter(0);
+		const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+		fs::path path = fs::temp_directory_path() / ("LVLExplorerTests_" + std::to_string(now) + "_" + std::to_string(counter++));
+		fs::create_directories(path);
+		m_path = path.string();
+	}
+
+	TempDirectory::~TempDirectory()
+	{
+		std::error_code error;
+		fs::remove_all(m_path, error);
+	}
+
+	const std::string& TempDirectory::GetPath() const
+	{
+		return m_path;
+	}
+
+	std::string TempDirectory::GetFilePath(const std::string& fileName) const
+	{
+		return (fs::path(m_path) / fileName).string();
+	}
+
+	bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& outData)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream.is_open())
+			return false;
+
+		outData.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+}
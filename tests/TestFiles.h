@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LVLExplorerTests
+{
+	/*
+	 * Builds synthetic ucfb chunk files in memory. Chunk sizes are filled in
+	 * once a chunk gets closed, every chunk is followed by zero padding up
+	 * to the next 4 byte boundary, just like in real level files.
+	 */
+	class ChunkWriter
+	{
+	public:
+		// Opens a chunk, returns the position of its header
+		uint64_t Begin(const char (&magic)[5]);
+
+		// Opens a sub level chunk, including the name hash and size prefix in front of its children
+		uint64_t BeginLevel(uint32_t nameHash);
+
+		void End();
+
+		// Writes a whole chunk with the given data, returns the position of its header
+		uint64_t Leaf(const char (&magic)[5], const std::string& data);
+
+		void Write(const void* data, size_t size);
+		void WriteUInt32(uint32_t value);
+
+		uint64_t GetPosition() const;
+		const std::vector<uint8_t>& GetData() const;
+		bool Save(const std::string& path) const;
+
+	private:
+		struct OpenChunk
+		{
+			uint64_t m_position;
+			bool m_bLevel;
+		};
+
+		std::vector<uint8_t> m_data;
+		std::vector<OpenChunk> m_open;
+
+	private:
+		void PatchUInt32(uint64_t position, uint32_t value);
+	};
+
+	// Unique, empty directory below the systems temp directory, removed again on destruction
+	class TempDirectory
+	{
+	public:
+		TempDirectory();
+		~TempDirectory();
+
+		const std::string& GetPath() const;
+		std::string GetFilePath(const std::string& fileName) const;
+
+	private:
+		std::string m_path;
+	};
+
+	bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& outData);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace LVLExplorerTests
+{
+	using TestFunction = void (*)();
+
+	struct TestCase
+	{
+		const char* m_suite;
+		const char* m_name;
+		TestFunction m_function;
+	};
+
+	// thrown by REQUIRE to abort the current test
+	struct TestAborted {};
+
+	std::vector<TestCase>& GetTestCases();
+	bool RegisterTest(const char* suite, const char* name, TestFunction function);
+	void ReportFailure(const char* file, int line, const std::string& message);
+}
+
+/*
+ * Minimal self registering test cases, so the tests do not need any
+ * dependency besides the core library. Each suite is run as its own
+ * CTest test, see CMakeLists.txt.
+ */
+#define TEST(suite, name) \
+	static void Test_##suite##_##name(); \
+	static const bool s_registered_##suite##_##name = LVLExplorerTests::RegisterTest(#suite, #name, &Test_##suite##_##name); \
+	static void Test_##suite##_##name()
+
+// records a failure and continues
+#define CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+			LVLExplorerTests::ReportFailure(__FILE__, __LINE__, "CHECK(" #condition ") failed"); \
+	} while (false)
+
+// records a failure and aborts the current test
+#define REQUIRE(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			LVLExplorerTests::ReportFailure(__FILE__, __LINE__, "REQUIRE(" #condition ") failed"); \
+			throw LVLExplorerTests::TestAborted(); \
+		} \
+	} while (false)
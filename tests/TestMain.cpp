@@ -0,0 +1,72 @@
+#include "TestFramework.h"
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+
+namespace LVLExplorerTests
+{
+	static size_t s_numFailures = 0;
+
+	std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	bool RegisterTest(const char* suite, const char* name, TestFunction function)
+	{
+		GetTestCases().push_back({ suite, name, function });
+		return true;
+	}
+
+	void ReportFailure(const char* file, int line, const std::string& message)
+	{
+		fprintf(stderr, "%s(%i): %s\n", file, line, message.c_str());
+		++s_numFailures;
+	}
+}
+
+using namespace LVLExplorerTests;
+
+// Usage: LVLExplorerTests [suite]
+int main(int argc, char* argv[])
+{
+	const char* suite = argc > 1 ? argv[1] : nullptr;
+
+	int numRun = 0;
+	int numFailed = 0;
+	for (const TestCase& test : GetTestCases())
+	{
+		if (suite != nullptr && strcmp(suite, test.m_suite) != 0)
+			continue;
+
+		size_t failuresBefore = s_numFailures;
+		try
+		{
+			test.m_function();
+		}
+		catch (TestAborted&)
+		{
+			// already reported
+		}
+		catch (std::exception& e)
+		{
+			ReportFailure(__FILE__, __LINE__, std::string("unexpected exception: ") + e.what());
+		}
+
+		bool bPassed = s_numFailures == failuresBefore;
+		printf("[%s] %s.%s\n", bPassed ? "  OK  " : "FAILED", test.m_suite, test.m_name);
+		numFailed += bPassed ? 0 : 1;
+		++numRun;
+	}
+
+	if (numRun == 0)
+	{
+		fprintf(stderr, "No tests found%s%s!\n", suite != nullptr ? " for suite " : "", suite != nullptr ? suite : "");
+		return 1;
+	}
+
+	printf("%i of %i tests passed\n", numRun - numFailed, numRun);
+	return numFailed > 0 ? 1 : 0;
+}
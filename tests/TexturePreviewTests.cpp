@@ -0,0 +1,62 @@
+#include "TestFramework.h"
+#include "Core/TexturePreview.h"
+#include <cstdlib>
+
+using namespace LVLExplorerTests;
+using LVLExplorerCore::CompositeRGBA;
+using LVLExplorerCore::PREVIEW_ALPHA_COLOR;
+
+
+// the float blend CompositeRGBA replaced
+static uint8_t FloatBlend(uint8_t color, uint8_t alphaColor, uint8_t alphaByte)
+{
+	float alpha = alphaByte / 255.f;
+	float transparency = 1.f - alpha;
+	return uint8_t(color * alpha + alphaColor * transparency);
+}
+
+TEST(TexturePreview, CompositeMatchesFloatBlend)
+{
+	// every color value with every alpha value
+	std::vector<uint8_t> rgba(256 * 256 * 4);
+	for (size_t i = 0; i < 256 * 256; ++i)
+	{
+		rgba[i * 4 + 0] = (uint8_t)(i % 256);
+		rgba[i * 4 + 1] = (uint8_t)(255 - i % 256);
+		rgba[i * 4 + 2] = (uint8_t)(i * 7 % 256);
+		rgba[i * 4 + 3] = (uint8_t)(i / 256);
+	}
+
+	std::vector<uint8_t> rgb(256 * 256 * 3);
+	CompositeRGBA(rgba.data(), 256 * 256, rgb.data());
+
+	size_t numMismatches = 0;
+	for (size_t i = 0; i < 256 * 256; ++i)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			int expected = FloatBlend(rgba[i * 4 + c], PREVIEW_ALPHA_COLOR[c], rgba[i * 4 + 3]);
+			int actual = rgb[i * 3 + c];
+
+			// the float version may truncate exact results to one below
+			if (actual != expected && actual != expected + 1)
+			{
+				++numMismatches;
+			}
+		}
+	}
+	CHECK(numMismatches == 0);
+}
+
+TEST(TexturePreview, CompositeOpaqueAndTransparent)
+{
+	const uint8_t rgba[] = {
+		10, 20, 30, 255,
+		10, 20, 30, 0
+	};
+	uint8_t rgb[6] = {};
+	CompositeRGBA(rgba, 2, rgb);
+
+	CHECK(rgb[0] == 10 && rgb[1] == 20 && rgb[2] == 30);
+	CHECK(rgb[3] == PREVIEW_ALPHA_COLOR[0] && rgb[4] == PREVIEW_ALPHA_COLOR[1] && rgb[5] == PREVIEW_ALPHA_COLOR[2]);
+}